@@ -11,11 +11,27 @@
 // ReSharper disable once CppUnusedIncludeDirective
 #include <yk/core/requirements.hpp>
 
+#include <initializer_list>
 #include <type_traits>
 #include <utility>
 
 #include <cstddef>
 
+// Compiler builtins used to avoid class template instantiations in pack
+// metafunctions; these are frequently queried against large packs.
+#if defined(__has_builtin)
+# if __has_builtin(__is_same)
+#  define YK_CORE_IS_SAME(T, U) __is_same(T, U)
+# endif
+# if __has_builtin(__type_pack_element)
+#  define YK_CORE_HAS_TYPE_PACK_ELEMENT 1
+# endif
+#endif
+
+#ifndef YK_CORE_IS_SAME
+# define YK_CORE_IS_SAME(T, U) ::std::is_same_v<T, U>
+#endif
+
 namespace yk::core {
 
 template<class T, template<class...> class TT>
@@ -106,6 +122,40 @@ struct at_c<I, TT<Ts...>>
 #  pragma clang diagnostic pop
 # endif
 // ----------------------------------------------------------
+#elif defined(YK_CORE_HAS_TYPE_PACK_ELEMENT) // no native pack indexing, but has the builtin
+
+// Wrapped in a class template so that the builtin never appears in a mangled name
+template<std::size_t I, class... Ts>
+struct pack_indexing
+{
+    static_assert(I < sizeof...(Ts));
+    using type = __type_pack_element<I, Ts...>;
+};
+
+template<std::size_t I, class... Ts>
+using pack_indexing_t = typename pack_indexing<I, Ts...>::type;
+
+# define YK_CORE_PACK_INDEXING(I, Ts_ellipsis) ::yk::core::pack_indexing_t<I, Ts_ellipsis>
+
+
+template<std::size_t I, auto... Ns>
+struct npack_indexing
+{
+    static_assert(I < sizeof...(Ns));
+    static constexpr auto value = __type_pack_element<I, std::integral_constant<decltype(Ns), Ns>...>::value;
+};
+
+template<std::size_t I, auto... Ns>
+constexpr auto npack_indexing_v = npack_indexing<I, Ns...>::value;
+
+
+template<std::size_t I, template<class...> class TT, class... Ts>
+struct at_c<I, TT<Ts...>>
+{
+    static_assert(I < sizeof...(Ts));
+    using type = __type_pack_element<I, Ts...>;
+};
+// ----------------------------------------------------------
 #else // no native pack indexing
 template<std::size_t I, class... Ts>
 struct pack_indexing
@@ -152,19 +202,17 @@ inline constexpr std::size_t find_npos = static_cast<std::size_t>(-1);
 
 namespace detail {
 
-template<std::size_t I, class T, class... Ts>
-struct find_index_impl
-    : std::integral_constant<std::size_t, find_npos>
-{};
-
-template<std::size_t I, class T, class U, class... Us>
-struct find_index_impl<I, T, U, Us...>
-    : std::conditional_t<
-        std::is_same_v<T, U>,
-        std::integral_constant<std::size_t, I>,
-        find_index_impl<I + 1, T, Us...>
-    >
-{};
+// A non-template function; the search is a single constant evaluation
+// instead of a chain of class template instantiations.
+[[nodiscard]] constexpr std::size_t find_first_true(std::initializer_list<bool> const bs) noexcept
+{
+    std::size_t i = 0;
+    for (bool const b : bs) {
+        if (b) return i;
+        ++i;
+    }
+    return find_npos;
+}
 
 } // detail
 
@@ -172,14 +220,16 @@ template<class T, class List>
 struct find_index;
 
 template<class T, template<class...> class TT, class... Ts>
-struct find_index<T, TT<Ts...>> : detail::find_index_impl<0, T, Ts...> {};
+struct find_index<T, TT<Ts...>>
+    : std::integral_constant<std::size_t, detail::find_first_true({YK_CORE_IS_SAME(T, Ts)...})>
+{};
 
 template<class T, class List>
 inline constexpr std::size_t find_index_v = find_index<T, List>::value;
 
 
 template<class T, class... Ts>
-struct is_in : std::disjunction<std::is_same<T, Ts>...> {};
+struct is_in : std::bool_constant<(YK_CORE_IS_SAME(T, Ts) || ...)> {};
 
 template<class T, class... Ts>
 inline constexpr bool is_in_v = is_in<T, Ts...>::value;
@@ -198,26 +248,12 @@ template<template<class A, class B> class F, class U, class... Ts>
 inline constexpr bool conjunction_for_v = conjunction_for<F, U, Ts...>::value;
 
 
-namespace detail {
-
-template<bool Found, class T, class... Us>
-struct exactly_once_impl : std::bool_constant<Found> {};
-
-template<class T, class U, class... Us>
-struct exactly_once_impl<false, T, U, Us...>
-    : exactly_once_impl<std::is_same_v<T, U>, T, Us...> {};
-
-template<class T, class U, class... Us>
-struct exactly_once_impl<true, T, U, Us...>
-    : std::conditional_t<std::is_same_v<T, U>, std::false_type, exactly_once_impl<true, T, Us...>> {};
-
-} // detail
-
 template<class T, class List>
 struct exactly_once;
 
 template<class T, template<class...> class TT, class... Ts>
-struct exactly_once<T, TT<Ts...>> : detail::exactly_once_impl<false, T, Ts...>
+struct exactly_once<T, TT<Ts...>>
+    : std::bool_constant<((static_cast<std::size_t>(YK_CORE_IS_SAME(T, Ts)) + ...) == 1)>
 {
     static_assert(sizeof...(Ts) > 0);
 };
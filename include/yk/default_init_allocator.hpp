@@ -5,6 +5,8 @@
 #ifndef YK_DEFAULT_INIT_ALLOCATOR_HPP
 #define YK_DEFAULT_INIT_ALLOCATOR_HPP
 
+#include <yk/for_overwrite.hpp>
+
 #include <memory>
 #include <new>
 #include <type_traits>
@@ -29,9 +31,14 @@ public:
     using A::A;
 
     template<class U>
-    constexpr void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+    constexpr void construct(U* ptr)
+        noexcept(is_for_overwrite_constructible_v<U> ? std::is_nothrow_constructible_v<U, for_overwrite_t> : std::is_nothrow_default_constructible_v<U>)
     {
-        ::new (static_cast<void*>(ptr)) U;
+        if constexpr (is_for_overwrite_constructible_v<U>) {
+            ::new (static_cast<void*>(ptr)) U(for_overwrite);
+        } else {
+            ::new (static_cast<void*>(ptr)) U;
+        }
     }
 
     template<class U, class... Args>
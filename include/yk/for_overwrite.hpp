@@ -0,0 +1,30 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef YK_FOR_OVERWRITE_HPP
+#define YK_FOR_OVERWRITE_HPP
+
+#include <type_traits>
+
+namespace yk {
+
+// Tag for constructing an object whose contents are going to be overwritten;
+// the constructor may leave (part of) the object representation indeterminate.
+struct for_overwrite_t
+{
+    constexpr explicit for_overwrite_t() = default;
+};
+
+inline constexpr for_overwrite_t for_overwrite{};
+
+// Opt-in; types which provide a `for_overwrite_t` constructor shall specialize this
+template<class T>
+struct is_for_overwrite_constructible : std::false_type {};
+
+template<class T>
+inline constexpr bool is_for_overwrite_constructible_v = is_for_overwrite_constructible<T>::value;
+
+} // yk
+
+#endif
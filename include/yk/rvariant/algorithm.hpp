@@ -0,0 +1,546 @@
+﻿#ifndef YK_RVARIANT_ALGORITHM_HPP
+#define YK_RVARIANT_ALGORITHM_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Bulk algorithms over ranges of rvariant
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/core/type_traits.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+# include <immintrin.h>
+#endif
+
+namespace yk {
+
+namespace detail {
+
+template<class Variant>
+struct is_bitwise_comparable_rvariant : std::false_type {};
+
+template<class... Ts>
+struct is_bitwise_comparable_rvariant<rvariant<Ts...>>
+    : std::bool_constant<is_bitwise_equality_comparable_all_v<Ts...> && is_uniform_size_v<Ts...>> {};
+
+template<class R1, class R2>
+concept bitwise_equal_ranges =
+    std::ranges::contiguous_range<R1> && std::ranges::sized_range<R1> &&
+    std::ranges::contiguous_range<R2> && std::ranges::sized_range<R2> &&
+    std::same_as<std::ranges::range_value_t<R1>, std::ranges::range_value_t<R2>> &&
+    is_bitwise_comparable_rvariant<std::ranges::range_value_t<R1>>::value;
+
+// Compares blocks of elements without branching on each element, so that
+// the compiler is able to vectorize the comparison of indices and values.
+template<class Variant>
+[[nodiscard]] bool bitwise_equal_n(Variant const* a, Variant const* b, std::size_t n) noexcept
+{
+    constexpr std::size_t block_size = 16;
+
+    for (; n >= block_size; n -= block_size, a += block_size, b += block_size) {
+        bool eq = true;
+        for (std::size_t i = 0; i < block_size; ++i) {
+            eq &= detail::bitwise_equal(a[i], b[i]);
+        }
+        if (!eq) return false;
+    }
+    bool eq = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        eq &= detail::bitwise_equal(a[i], b[i]);
+    }
+    return eq;
+}
+
+} // detail
+
+
+// Equivalent to `std::ranges::equal(r1, r2)`. If both ranges are contiguous
+// ranges of the same specialization of `rvariant` whose alternatives are
+// integral or pointer types of the same size, elements are compared by their
+// index and object representation in blocks.
+template<std::ranges::input_range R1, std::ranges::input_range R2>
+    requires std::indirectly_comparable<std::ranges::iterator_t<R1>, std::ranges::iterator_t<R2>, std::ranges::equal_to>
+[[nodiscard]] constexpr bool equal(R1&& r1, R2&& r2)
+{
+    if constexpr (detail::bitwise_equal_ranges<R1, R2>) {
+        if !consteval {
+            auto const n = std::ranges::size(r1);
+            if (n != std::ranges::size(r2)) return false;
+            return detail::bitwise_equal_n(std::ranges::data(r1), std::ranges::data(r2), static_cast<std::size_t>(n));
+        }
+    }
+    return std::ranges::equal(r1, r2);
+}
+
+namespace detail {
+
+template<class R>
+concept contiguous_rvariant_range =
+    std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+    core::is_ttp_specialization_of_v<std::ranges::range_value_t<R>, rvariant>;
+
+template<class R>
+concept rvariant_range =
+    std::ranges::input_range<R> &&
+    core::is_ttp_specialization_of_v<std::ranges::range_value_t<R>, rvariant>;
+
+// Neither an alternative nor `std::variant_npos`; no element holds such an index.
+// Checked by the entry points, as `to_raw_index` would wrap it to a valid one.
+template<class Variant>
+[[nodiscard]] constexpr bool is_out_of_range_index(std::size_t const i) noexcept
+{
+    return i >= variant_size_v<Variant> && i != std::variant_npos;
+}
+
+// `std::variant_npos` is mapped to the valueless state
+template<class Variant>
+[[nodiscard]] constexpr typename index_access<Variant>::index_type to_raw_index(std::size_t const i) noexcept
+{
+    assert(!detail::is_out_of_range_index<Variant>(i));
+    return static_cast<typename index_access<Variant>::index_type>(i);
+}
+
+#if defined(__AVX2__)
+
+// Loads the indices of 8 consecutive elements with a single gather. Each lane
+// reads 4 bytes starting at the index, so the caller must guarantee that at
+// least one element follows the block.
+template<class Variant>
+class index_gather
+{
+    using access = index_access<Variant>;
+    using index_type = typename access::index_type;
+
+    static constexpr std::uint32_t index_mask =
+        sizeof(index_type) >= 4 ? 0xffffffffu : (1u << (8 * sizeof(index_type))) - 1u;
+
+public:
+    static constexpr bool enabled = sizeof(Variant) >= 4 && sizeof(Variant) * 8 <= 0x7fffffff;
+    static constexpr std::size_t block_size = 8;
+
+    index_gather(Variant const* const first, std::size_t const i) noexcept
+        : base_(reinterpret_cast<unsigned char const*>(first) + access::offset(*first))
+        , offsets_(_mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(sizeof(Variant)))))
+        , mask_(_mm256_set1_epi32(static_cast<int>(index_mask)))
+        , needle_(_mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(detail::to_raw_index<Variant>(i)) & index_mask)))
+    {}
+
+    // bit `j` is set if the element `k + j` holds the alternative
+    [[nodiscard]] unsigned match(std::size_t const k) const noexcept
+    {
+        __m256i const indices = _mm256_and_si256(
+            _mm256_i32gather_epi32(reinterpret_cast<int const*>(base_ + k * sizeof(Variant)), offsets_, 1),
+            mask_
+        );
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(indices, needle_))));
+    }
+
+private:
+    unsigned char const* base_;
+    __m256i offsets_, mask_, needle_;
+};
+
+#endif
+
+template<class Variant>
+[[nodiscard]] std::size_t count_index_n(Variant const* const first, std::size_t const n, std::size_t const i) noexcept
+{
+    std::size_t count = 0;
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    if constexpr (index_gather<Variant>::enabled) {
+        index_gather<Variant> const gather(first, i);
+        for (; k + index_gather<Variant>::block_size < n; k += index_gather<Variant>::block_size) {
+            count += static_cast<std::size_t>(std::popcount(gather.match(k)));
+        }
+    }
+#endif
+    auto const target = detail::to_raw_index<Variant>(i);
+    for (; k < n; ++k) {
+        count += index_access<Variant>::raw_index(first[k]) == target;
+    }
+    return count;
+}
+
+template<class Variant>
+[[nodiscard]] std::size_t find_index_n(Variant const* const first, std::size_t const n, std::size_t const i) noexcept
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    if constexpr (index_gather<Variant>::enabled) {
+        index_gather<Variant> const gather(first, i);
+        for (; k + index_gather<Variant>::block_size < n; k += index_gather<Variant>::block_size) {
+            if (unsigned const m = gather.match(k)) return k + static_cast<std::size_t>(std::countr_zero(m));
+        }
+    }
+#endif
+    auto const target = detail::to_raw_index<Variant>(i);
+    for (; k < n; ++k) {
+        if (index_access<Variant>::raw_index(first[k]) == target) return k;
+    }
+    return n;
+}
+
+template<class Variant, class Out>
+[[nodiscard]] Out indices_of_n(Variant const* const first, std::size_t const n, std::size_t const i, Out out)
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    if constexpr (index_gather<Variant>::enabled) {
+        index_gather<Variant> const gather(first, i);
+        for (; k + index_gather<Variant>::block_size < n; k += index_gather<Variant>::block_size) {
+            for (unsigned m = gather.match(k); m != 0; m &= m - 1) {
+                *out = k + static_cast<std::size_t>(std::countr_zero(m));
+                ++out;
+            }
+        }
+    }
+#endif
+    auto const target = detail::to_raw_index<Variant>(i);
+    for (; k < n; ++k) {
+        if (index_access<Variant>::raw_index(first[k]) == target) {
+            *out = k;
+            ++out;
+        }
+    }
+    return out;
+}
+
+} // detail
+
+
+// Number of elements which hold the `i`-th alternative. If `i` is
+// `std::variant_npos`, counts the valueless elements.
+template<std::ranges::input_range R>
+    requires detail::rvariant_range<R>
+[[nodiscard]] constexpr std::size_t count_index(R&& r, std::size_t const i)
+{
+    if (detail::is_out_of_range_index<std::ranges::range_value_t<R>>(i)) return 0;
+
+    if constexpr (detail::contiguous_rvariant_range<R>) {
+        if !consteval {
+            return detail::count_index_n(std::ranges::data(r), static_cast<std::size_t>(std::ranges::size(r)), i);
+        }
+    }
+    std::size_t count = 0;
+    for (auto const& v : r) {
+        count += v.index() == i;
+    }
+    return count;
+}
+
+// Number of elements for each alternative; the last bucket counts the valueless elements.
+template<std::ranges::input_range R>
+    requires detail::rvariant_range<R>
+[[nodiscard]] constexpr std::array<std::size_t, variant_size_v<std::ranges::range_value_t<R>> + 1>
+index_histogram(R&& r)
+{
+    constexpr std::size_t N = variant_size_v<std::ranges::range_value_t<R>>;
+
+    // Interleaved sub-histograms hide the latency of consecutive
+    // increments on the same bucket.
+    std::array<std::array<std::size_t, N + 1>, 4> partial{};
+    std::size_t k = 0;
+    for (auto const& v : r) {
+        std::size_t const i = v.index();
+        ++partial[k++ % 4][i < N ? i : N];
+    }
+
+    std::array<std::size_t, N + 1> hist{};
+    for (auto const& p : partial) {
+        for (std::size_t i = 0; i <= N; ++i) hist[i] += p[i];
+    }
+    return hist;
+}
+
+// The first element which holds the `i`-th alternative, or the end
+template<std::ranges::input_range R>
+    requires detail::rvariant_range<R>
+[[nodiscard]] constexpr std::ranges::borrowed_iterator_t<R> find_index(R&& r, std::size_t const i)
+{
+    if (detail::is_out_of_range_index<std::ranges::range_value_t<R>>(i)) {
+        return std::ranges::next(std::ranges::begin(r), std::ranges::end(r));
+    }
+
+    if constexpr (detail::contiguous_rvariant_range<R>) {
+        if !consteval {
+            auto const pos = detail::find_index_n(std::ranges::data(r), static_cast<std::size_t>(std::ranges::size(r)), i);
+            return std::ranges::next(std::ranges::begin(r), static_cast<std::ranges::range_difference_t<R>>(pos));
+        }
+    }
+    return std::ranges::find_if(r, [i](auto const& v) { return v.index() == i; });
+}
+
+// Writes the positions of the elements which hold the `i`-th alternative, in ascending order.
+template<std::ranges::input_range R, std::weakly_incrementable Out>
+    requires detail::rvariant_range<R> && std::indirectly_writable<Out, std::size_t>
+constexpr Out indices_of(R&& r, std::size_t const i, Out out)
+{
+    if (detail::is_out_of_range_index<std::ranges::range_value_t<R>>(i)) return out;
+
+    if constexpr (detail::contiguous_rvariant_range<R>) {
+        if !consteval {
+            return detail::indices_of_n(std::ranges::data(r), static_cast<std::size_t>(std::ranges::size(r)), i, std::move(out));
+        }
+    }
+    std::size_t k = 0;
+    for (auto const& v : r) {
+        if (v.index() == i) {
+            *out = k;
+            ++out;
+        }
+        ++k;
+    }
+    return out;
+}
+
+namespace detail {
+
+template<std::size_t N, class Variant>
+[[nodiscard]] YK_FORCEINLINE constexpr std::size_t index_bucket(Variant const& v) noexcept
+{
+    std::size_t const i = v.index();
+    return i < N ? i : N;
+}
+
+template<std::size_t N>
+[[nodiscard]] constexpr std::array<std::size_t, N + 2> index_bounds(std::array<std::size_t, N + 1> const& hist) noexcept
+{
+    std::array<std::size_t, N + 2> bounds{};
+    for (std::size_t b = 0; b <= N; ++b) {
+        bounds[b + 1] = bounds[b] + hist[b];
+    }
+    return bounds;
+}
+
+template<class Variant>
+YK_FORCEINLINE constexpr void swap_elements(Variant& a, Variant& b)
+    noexcept(std::is_nothrow_swappable_v<Variant>)
+{
+    if constexpr (std::is_trivially_copyable_v<Variant>) {
+        if !consteval {
+            alignas(Variant) unsigned char tmp[sizeof(Variant)];
+            std::memcpy(tmp, std::addressof(a), sizeof(Variant));
+            std::memcpy(std::addressof(a), std::addressof(b), sizeof(Variant));
+            std::memcpy(std::addressof(b), tmp, sizeof(Variant));
+            return;
+        }
+    }
+    std::ranges::swap(a, b);
+}
+
+} // detail
+
+
+// Reorders the elements so that they are grouped by the held alternative, in
+// ascending order of the index, followed by the valueless elements. The
+// relative order of the elements in a group is not preserved. O(n) swaps.
+//
+// Returns the boundaries `b` such that the elements holding the `k`-th
+// alternative are in `[b[k], b[k + 1])`, and the valueless elements are in
+// `[b[N], b[N + 1])` where `N` is the number of alternatives.
+template<std::ranges::random_access_range R>
+    requires
+        detail::rvariant_range<R> && std::ranges::sized_range<R> &&
+        std::permutable<std::ranges::iterator_t<R>>
+constexpr std::array<std::size_t, variant_size_v<std::ranges::range_value_t<R>> + 2>
+partition_by_index(R&& r)
+{
+    constexpr std::size_t N = variant_size_v<std::ranges::range_value_t<R>>;
+    auto const first = std::ranges::begin(r);
+    auto const bounds = detail::index_bounds<N>(yk::index_histogram(r));
+
+    std::array<std::size_t, N + 1> heads{};
+    std::copy_n(bounds.begin(), N + 1, heads.begin());
+
+    for (std::size_t b = 0; b <= N; ++b) {
+        while (heads[b] < bounds[b + 1]) {
+            auto& v = first[static_cast<std::ranges::range_difference_t<R>>(heads[b])];
+            std::size_t const t = detail::index_bucket<N>(v);
+            if (t == b) {
+                ++heads[b];
+            } else {
+                detail::swap_elements(v, first[static_cast<std::ranges::range_difference_t<R>>(heads[t]++)]);
+            }
+        }
+    }
+    return bounds;
+}
+
+// Same as `partition_by_index`, except that the relative order of the
+// elements in a group is preserved. O(n) moves through a buffer of `n`
+// elements; trivially copyable elements of a contiguous range are copied
+// bytewise.
+template<std::ranges::random_access_range R>
+    requires
+        detail::rvariant_range<R> && std::ranges::sized_range<R> &&
+        std::is_move_constructible_v<std::ranges::range_value_t<R>> &&
+        std::is_move_assignable_v<std::ranges::range_value_t<R>>
+std::array<std::size_t, variant_size_v<std::ranges::range_value_t<R>> + 2>
+counting_sort_by_index(R&& r)
+{
+    using V = std::ranges::range_value_t<R>;
+    using D = std::ranges::range_difference_t<R>;
+    constexpr std::size_t N = variant_size_v<V>;
+
+    auto const first = std::ranges::begin(r);
+    auto const n = static_cast<std::size_t>(std::ranges::size(r));
+    auto const bounds = detail::index_bounds<N>(yk::index_histogram(r));
+    if (n == 0) return bounds;
+
+    std::array<std::size_t, N + 1> heads{};
+    std::copy_n(bounds.begin(), N + 1, heads.begin());
+
+    std::allocator<V> alloc;
+    V* const buf = alloc.allocate(n);
+
+    if constexpr (std::is_trivially_copyable_v<V> && std::ranges::contiguous_range<R>) {
+        V* const data = std::ranges::data(r);
+        for (std::size_t k = 0; k < n; ++k) {
+            std::memcpy(buf + heads[detail::index_bucket<N>(data[k])]++, data + k, sizeof(V));
+        }
+        std::memcpy(data, buf, n * sizeof(V));
+        alloc.deallocate(buf, n);
+
+    } else {
+        // Constructed elements of the buffer are `[bounds[b], heads[b])` for each bucket `b`
+        struct guard
+        {
+            std::allocator<V>& alloc;
+            V* buf;
+            std::size_t n;
+            std::array<std::size_t, N + 2> const& bounds;
+            std::array<std::size_t, N + 1> const& heads;
+
+            ~guard()
+            {
+                for (std::size_t b = 0; b <= N; ++b) {
+                    std::destroy(buf + bounds[b], buf + heads[b]);
+                }
+                alloc.deallocate(buf, n);
+            }
+        } const g{alloc, buf, n, bounds, heads};
+
+        for (std::size_t k = 0; k < n; ++k) {
+            auto& v = first[static_cast<D>(k)];
+            std::size_t& head = heads[detail::index_bucket<N>(v)];
+            std::construct_at(buf + head, std::move(v));
+            ++head;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+            first[static_cast<D>(k)] = std::move(buf[k]);
+        }
+    }
+    return bounds;
+}
+
+namespace detail {
+
+template<class From, class To>
+struct is_bitwise_convertible : std::false_type {};
+
+// Every alternative is trivially copyable and is not wrapped in `To`
+template<class... Us, class... Ts>
+    requires rvariant_set::subset_of<rvariant<Us...>, rvariant<Ts...>>
+struct is_bitwise_convertible<rvariant<Us...>, rvariant<Ts...>> : std::bool_constant<
+    std::is_trivially_copyable_v<rvariant<Us...>> &&
+    std::is_trivially_copyable_v<rvariant<Ts...>> &&
+    is_never_valueless_v<Us...> &&
+    std::conjunction_v<std::is_same<select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us>...>
+> {};
+
+template<class From, class To>
+struct bitwise_convert;
+
+template<class... Us, class... Ts>
+struct bitwise_convert<rvariant<Us...>, rvariant<Ts...>>
+{
+    using From = rvariant<Us...>;
+    using To = rvariant<Ts...>;
+
+    using index_type = typename index_access<To>::index_type;
+
+    static constexpr std::array<index_type, sizeof...(Us)> table = [] {
+        using reindex = subset_reindex_impl<core::type_list<unwrap_recursive_t<Us>...>, core::type_list<unwrap_recursive_t<Ts>...>>;
+        std::array<index_type, sizeof...(Us)> t{};
+        for (std::size_t i = 0; i < sizeof...(Us); ++i) {
+            t[i] = static_cast<index_type>(reindex::table[i]);
+        }
+        return t;
+    }();
+
+    // Copies the whole storage, so that no dispatch on the index is required.
+    // The storage of `To` is at least as large as that of `From`, since the
+    // alternatives of `To` are a superset.
+    static void apply(From const* const src, To* const dst, std::size_t const n) noexcept
+    {
+        static_assert(sizeof(make_variadic_union_t<Us...>) <= sizeof(make_variadic_union_t<Ts...>));
+
+        for (std::size_t k = 0; k < n; ++k) {
+            std::memcpy(
+                std::addressof(detail::forward_storage<To&>(dst[k])),
+                std::addressof(detail::forward_storage<From const&>(src[k])),
+                sizeof(make_variadic_union_t<Us...>)
+            );
+            auto const i = static_cast<std::size_t>(index_access<From>::raw_index(src[k]));
+            index_access<To>::set_raw_index(dst[k], table[i]);
+        }
+    }
+};
+
+} // detail
+
+
+// Assigns `To(v)` to the successive elements of `out` for each `v` in `src`.
+// If `src` is a contiguous sized range, `out` is a contiguous iterator to
+// `To`, and the alternatives are trivially copyable and unwrapped in `To`,
+// the elements are converted by copying the storage and remapping the index
+// through a table, without dispatching on the index of each element.
+template<class To, std::ranges::input_range R, std::weakly_incrementable Out>
+    requires
+        core::is_ttp_specialization_of_v<To, rvariant> &&
+        detail::rvariant_range<R> &&
+        std::constructible_from<To, std::ranges::range_reference_t<R>> &&
+        std::indirectly_writable<Out, To>
+constexpr Out convert_range(R&& src, Out out)
+{
+    using From = std::ranges::range_value_t<R>;
+
+    if constexpr (
+        std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+        std::contiguous_iterator<Out> && std::same_as<std::iter_value_t<Out>, To> &&
+        detail::is_bitwise_convertible<From, To>::value
+    ) {
+        if !consteval {
+            auto const n = static_cast<std::size_t>(std::ranges::size(src));
+            detail::bitwise_convert<From, To>::apply(std::ranges::data(src), std::to_address(out), n);
+            return out + static_cast<std::iter_difference_t<Out>>(n);
+        }
+    }
+    for (auto&& v : src) {
+        *out = To(std::forward<decltype(v)>(v));
+        ++out;
+    }
+    return out;
+}
+
+} // yk
+
+#endif
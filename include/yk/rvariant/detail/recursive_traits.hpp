@@ -10,34 +10,23 @@
 
 namespace yk::detail {
 
-template<bool Found, std::size_t I, class U, class... Ts>
-struct select_maybe_wrapped_impl;
+template<class U, class T>
+constexpr bool is_maybe_wrapped_v = YK_CORE_IS_SAME(U, T);
 
-template<std::size_t I, class U, class... Rest>
-struct select_maybe_wrapped_impl<false, I, U, U, Rest...>
-{
-    using type = U;
-    static constexpr std::size_t index = I;
-};
-
-template<std::size_t I, class U, class Allocator, class... Rest>
-struct select_maybe_wrapped_impl<false, I, U, recursive_wrapper<U, Allocator>, Rest...>
-{
-    using type = recursive_wrapper<U, Allocator>;
-    static constexpr std::size_t index = I;
-};
-
-template<std::size_t I, class U, class First, class... Rest>
-struct select_maybe_wrapped_impl<false, I, U, First, Rest...>
-    : select_maybe_wrapped_impl<false, I + 1, U, Rest...>
-{};
+template<class U, class Allocator>
+constexpr bool is_maybe_wrapped_v<U, recursive_wrapper<U, Allocator>> = true;
 
 template<class U, class... Ts>
-struct select_maybe_wrapped : select_maybe_wrapped_impl<false, 0, U, Ts...>
+struct select_maybe_wrapped
 {
     // Precondition: either T or recursive_wrapper<T> occurs at least once in Ts...
     static_assert(sizeof...(Ts) > 0);
     static_assert(!core::is_ttp_specialization_of_v<U, recursive_wrapper>);
+
+    static constexpr std::size_t index = core::detail::find_first_true({is_maybe_wrapped_v<U, Ts>...});
+    static_assert(index != core::find_npos);
+
+    using type = core::pack_indexing_t<index, Ts...>;
 };
 
 template<class U, class... Ts>
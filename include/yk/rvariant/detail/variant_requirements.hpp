@@ -128,6 +128,35 @@ struct variant_nothrow_assignable : std::conjunction<std::is_nothrow_constructib
     static_assert(variant_assignable<T, U>::value);
 };
 
+// `assign_or_emplace` assigns into the contained value only when given exactly one argument
+template<class T, class... Args>
+struct variant_reassignable : std::false_type
+{
+    static_assert(!std::is_reference_v<T>);
+};
+
+template<class T, class Arg>
+struct variant_reassignable<T, Arg> : std::is_assignable<T&, Arg>
+{
+    static_assert(!std::is_reference_v<T>);
+};
+
+template<class T, class... Args>
+struct variant_nothrow_assign_or_emplace : std::false_type
+{
+    static_assert(!std::is_reference_v<T>);
+};
+
+template<class T, class... Args>
+    requires (!variant_reassignable<T, Args...>::value)
+struct variant_nothrow_assign_or_emplace<T, Args...> : std::is_nothrow_constructible<T, Args...>
+{};
+
+template<class T, class Arg>
+    requires variant_reassignable<T, Arg>::value
+struct variant_nothrow_assign_or_emplace<T, Arg> : std::conjunction<std::is_nothrow_constructible<T, Arg>, std::is_nothrow_assignable<T&, Arg>>
+{};
+
 } // yk::detail
 
 #endif
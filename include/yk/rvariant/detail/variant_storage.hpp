@@ -97,17 +97,23 @@ template<class Variant, class T>
 // Furthermore, we have modified the spec for `.emplace` so that
 // `recursive_wrapper` can be always treated as never_valueless part,
 // so we include that optimization for PoC.
+//
+// Optionally (`rvariant_policy<Ts...>::nothrow_move_never_valueless`),
+// any nothrow move constructible type is treated as never_valueless part
+// by applying the same construct-then-move strategy with a non-trivial move.
 
-// Additional size limit
-inline constexpr std::size_t never_valueless_trivial_size_limit = 256;
-
+// Additional size limit; customizable via `rvariant_policy<Ts...>`
 template<class... Ts>
 struct is_never_valueless
     : std::conjunction<
         std::disjunction<
             core::is_ttp_specialization_of<Ts, recursive_wrapper>,
             std::conjunction<
-                std::bool_constant<sizeof(Ts) <= never_valueless_trivial_size_limit>,
+                std::bool_constant<rvariant_policy_traits<Ts...>::nothrow_move_never_valueless>,
+                std::is_nothrow_move_constructible<Ts>
+            >,
+            std::conjunction<
+                std::bool_constant<sizeof(Ts) <= rvariant_policy_traits<Ts...>::never_valueless_trivial_size_limit>,
                 std::is_trivially_destructible<Ts>,
                 std::disjunction<std::is_trivially_move_constructible<Ts>, std::is_trivially_copy_constructible<Ts>>,
                 std::disjunction<std::is_trivially_move_assignable<Ts>, std::is_trivially_copy_assignable<Ts>>
@@ -171,6 +177,13 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         noexcept(std::is_nothrow_constructible_v<T, Args...>)
         : first(std::forward<Args>(args)...) // value-initialize; https://eel.is/c++draft/variant.ctor#3
     {}
+
+    template<class F>
+        requires is_invoke_constructible<T, F>::value
+    constexpr explicit variadic_union(std::in_place_index_t<0>, from_invoke_t, F&& f)
+        noexcept(is_nothrow_invoke_constructible<T, F>::value)
+        : first(std::invoke(std::forward<F>(f))) // guaranteed copy elision if the result is a prvalue of `T`
+    {}
 YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
 
     template<std::size_t I, class... Args>
@@ -219,6 +232,13 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         noexcept(std::is_nothrow_constructible_v<T, Args...>)
         : first(std::forward<Args>(args)...) // value-initialize; https://eel.is/c++draft/variant.ctor#3
     {}
+
+    template<class F>
+        requires is_invoke_constructible<T, F>::value
+    constexpr explicit variadic_union(std::in_place_index_t<0>, from_invoke_t, F&& f)
+        noexcept(is_nothrow_invoke_constructible<T, F>::value)
+        : first(std::invoke(std::forward<F>(f))) // guaranteed copy elision if the result is a prvalue of `T`
+    {}
 YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
 
     template<std::size_t I, class... Args>
@@ -7,6 +7,7 @@
 // https://www.boost.org/LICENSE_1_0.txt
 
 #include <yk/rvariant/detail/rvariant_fwd.hpp>
+#include <yk/rvariant/detail/variant_requirements.hpp>
 #include <yk/rvariant/detail/variant_storage.hpp>
 #include <yk/rvariant/variant_helper.hpp>
 
@@ -14,11 +15,13 @@
 #include <yk/core/type_traits.hpp>
 
 #include <variant> // std::bad_variant_access
+#include <concepts>
 #include <utility>
 #include <functional>
 #include <type_traits>
 
 #include <cstddef>
+#include <cstdint>
 
 
 namespace yk {
@@ -372,6 +375,38 @@ struct visit_R_check_impl<R, Visitor, core::type_list<Args...>, rvariant<Ts...>
 template<class R, class Visitor, class... Variants>
 using visit_R_check = visit_R_check_impl<R, Visitor, core::type_list<>, Variants...>;
 
+// The argument type for the alternative `I`, as in `visit_check_impl`
+template<std::size_t I, class Variant>
+struct visit_check_arg;
+
+template<std::size_t I, class... Ts>
+struct visit_check_arg<I, rvariant<Ts...>&> { using type = unwrap_recursive_t<core::pack_indexing_t<I, Ts...>>&; };
+template<std::size_t I, class... Ts>
+struct visit_check_arg<I, rvariant<Ts...> const&> { using type = unwrap_recursive_t<core::pack_indexing_t<I, Ts...>> const&; };
+template<std::size_t I, class... Ts>
+struct visit_check_arg<I, rvariant<Ts...>&&> { using type = unwrap_recursive_t<core::pack_indexing_t<I, Ts...>>; };
+template<std::size_t I, class... Ts>
+struct visit_check_arg<I, rvariant<Ts...> const&&> { using type = unwrap_recursive_t<core::pack_indexing_t<I, Ts...>> const; };
+
+// Same as `visit_check` and `visit_R_check`, except that only the combinations
+// of alternatives listed in `CheckSeq` (a `type_list` of `index_sequence`) are checked
+template<template<class, class, class, class...> class CheckImpl, class T0R, class Visitor, class CheckSeq, class... Variants>
+struct visit_seq_check_impl;
+
+template<template<class, class, class, class...> class CheckImpl, class T0R, class Visitor, class... CheckSeq, class... Variants>
+struct visit_seq_check_impl<CheckImpl, T0R, Visitor, core::type_list<CheckSeq...>, Variants...>
+    : std::conjunction<visit_seq_check_impl<CheckImpl, T0R, Visitor, CheckSeq, Variants...>...> {};
+
+template<template<class, class, class, class...> class CheckImpl, class T0R, class Visitor, std::size_t... Is, class... Variants>
+struct visit_seq_check_impl<CheckImpl, T0R, Visitor, std::index_sequence<Is...>, Variants...>
+    : CheckImpl<T0R, Visitor, core::type_list<typename visit_check_arg<Is, Variants>::type...>> {};
+
+template<class T0R, class Visitor, class CheckSeq, class... Variants>
+using visit_seq_check = visit_seq_check_impl<visit_check_impl, T0R, Visitor, CheckSeq, Variants...>;
+
+template<class R, class Visitor, class CheckSeq, class... Variants>
+using visit_R_seq_check = visit_seq_check_impl<visit_R_check_impl, R, Visitor, CheckSeq, Variants...>;
+
 
 // --------------------------------------------------
 
@@ -602,6 +637,211 @@ struct visit_impl<
     }
 };
 
+
+// The pairs `(i, j)` of indices with `i <= j < N`, in row-major order
+template<std::size_t N>
+struct upper_triangle
+{
+    static constexpr std::size_t size = N * (N + 1) / 2;
+
+    [[nodiscard]] YK_FORCEINLINE static constexpr std::size_t
+    flat_index(std::size_t const i, std::size_t const j) noexcept
+    {
+        assert(i <= j && j < N);
+        return i * (2 * N - i - 1) / 2 + j;
+    }
+
+private:
+    struct pairs_type
+    {
+        std::size_t i[size];
+        std::size_t j[size];
+    };
+
+    static constexpr pairs_type pairs = [] {
+        pairs_type res{};
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = i; j < N; ++j, ++k) {
+                res.i[k] = i;
+                res.j[k] = j;
+            }
+        }
+        return res;
+    }();
+
+    template<std::size_t... Ks>
+    static core::type_list<std::index_sequence<pairs.i[Ks], pairs.j[Ks]>...> make_OverloadSeq(std::index_sequence<Ks...>);
+
+public:
+    using OverloadSeq = decltype(upper_triangle::make_OverloadSeq(std::make_index_sequence<size>{}));
+};
+
+// Dispatches on the upper triangle of the product of the (biased) indices;
+// for `i > j`, the arguments are swapped at runtime. Both variants are
+// forwarded as `Variant`, so that both orders share the same table.
+template<class R, class Variant>
+struct visit_commutative_impl
+{
+    using variant_type = std::remove_cvref_t<Variant>;
+    using triangle = upper_triangle<detail::valueless_bias<variant_type>(yk::variant_size_v<variant_type>)>;
+    using OverloadSeq = typename triangle::OverloadSeq;
+
+    // without the valueless state
+    using CheckSeq = typename upper_triangle<yk::variant_size_v<variant_type>>::OverloadSeq;
+
+    template<class Visitor>
+    static constexpr bool nothrow =
+        multi_visit_noexcept<R, OverloadSeq, Visitor, forward_storage_t<Variant>, forward_storage_t<Variant>>::value;
+
+    template<class Visitor, class Variant1, class Variant2>
+    static constexpr R apply(Visitor&& vis, Variant1&& a, Variant2&& b)  // NOLINT(cppcoreguidelines-missing-std-forward)
+        YK_RVARIANT_VISIT_NOEXCEPT(nothrow<Visitor>)
+    {
+        std::size_t const i = detail::valueless_bias<variant_type>(a.index_);
+        std::size_t const j = detail::valueless_bias<variant_type>(b.index_);
+
+        if (i <= j) {
+            return visit_dispatch<visit_strategy<OverloadSeq::size>>::template apply<R, OverloadSeq>(
+                triangle::flat_index(i, j), std::forward<Visitor>(vis),
+                forward_storage<Variant>(a), forward_storage<Variant>(b)
+            );
+        } else {
+            return visit_dispatch<visit_strategy<OverloadSeq::size>>::template apply<R, OverloadSeq>(
+                triangle::flat_index(j, i), std::forward<Visitor>(vis),
+                forward_storage<Variant>(b), forward_storage<Variant>(a)
+            );
+        }
+    }
+};
+
+// The common qualification of the two variants of `visit_commutative`;
+// e.g. `rvariant<Ts...> const&` for `rvariant<Ts...>&` and `rvariant<Ts...> const&`
+template<class Variant1, class Variant2>
+using visit_commutative_variant_t = std::common_reference_t<as_variant_t<Variant1>, as_variant_t<Variant2>>;
+
+// Dispatches on the diagonal of the product of the (biased) indices;
+// if the indices differ, calls the mismatch handler with the variants.
+template<class R, class Variant>
+struct visit_same_impl
+{
+    template<std::size_t... Is>
+    static core::type_list<std::index_sequence<Is, Is>...> make_OverloadSeq(std::index_sequence<Is...>);
+
+    using OverloadSeq = decltype(visit_same_impl::make_OverloadSeq(
+        std::make_index_sequence<detail::valueless_bias<Variant>(yk::variant_size_v<Variant>)>{}
+    ));
+
+    // without the valueless state
+    using CheckSeq = decltype(visit_same_impl::make_OverloadSeq(std::make_index_sequence<yk::variant_size_v<Variant>>{}));
+
+    template<class Visitor, class Mismatch, class Variant1, class Variant2>
+    static constexpr bool nothrow =
+        multi_visit_noexcept<R, OverloadSeq, Visitor, forward_storage_t<as_variant_t<Variant1>>, forward_storage_t<as_variant_t<Variant2>>>::value &&
+        std::is_nothrow_invocable_r_v<R, Mismatch, Variant1, Variant2>;
+
+    template<class Visitor, class Mismatch, class Variant1, class Variant2>
+    static constexpr R apply(Visitor&& vis, Mismatch&& mismatch, Variant1&& a, Variant2&& b)  // NOLINT(cppcoreguidelines-missing-std-forward)
+        YK_RVARIANT_VISIT_NOEXCEPT(nothrow<Visitor, Mismatch, Variant1, Variant2>)
+    {
+        static_assert(
+            std::is_invocable_r_v<R, Mismatch, Variant1, Variant2>,
+            "The mismatch handler must be invocable with both variants, and its result must be convertible to the result of the visitor."
+        );
+        if (a.index_ != b.index_) [[unlikely]] {
+            return std::invoke_r<R>(std::forward<Mismatch>(mismatch), std::forward<Variant1>(a), std::forward<Variant2>(b));
+        }
+        return visit_dispatch<visit_strategy<OverloadSeq::size>>::template apply<R, OverloadSeq>(
+            detail::valueless_bias<Variant>(a.index_), std::forward<Visitor>(vis),
+            forward_storage<as_variant_t<Variant1>>(a), forward_storage<as_variant_t<Variant2>>(b)
+        );
+    }
+};
+
+template<std::size_t I, class Visitor, class Variant>
+using visit_some_result_t = decltype(std::invoke(
+    std::declval<Visitor>(),
+    unwrap_recursive(detail::raw_get<I>(forward_storage<Variant>(std::declval<Variant>())))
+));
+
+// Tests the index only against the selected indices `Is...`. If the biased
+// indices fit in 64 bits, a bitmask test sends every other alternative to
+// the fallback with a single branch.
+template<class R, class Variant, std::size_t... Is>
+struct visit_some_impl
+{
+    static_assert(sizeof...(Is) > 0);
+    static_assert(((Is < yk::variant_size_v<Variant>) && ...), "Each selected index must be less than the number of alternatives.");
+
+    static constexpr bool use_mask = detail::valueless_bias<Variant>(yk::variant_size_v<Variant>) <= 64;
+    static constexpr std::uint64_t mask = use_mask ? ((std::uint64_t{1} << detail::valueless_bias<Variant>(Is)) | ...) : 0;
+
+    using CheckSeq = core::type_list<std::index_sequence<Is>...>;
+
+    template<std::size_t I, class V>
+    using arg_t = decltype(unwrap_recursive(detail::raw_get<I>(forward_storage<as_variant_t<V>>(std::declval<V>()))));
+
+    template<class Visitor, class Fallback, class V>
+    static constexpr bool nothrow =
+        (std::is_nothrow_invocable_r_v<R, Visitor, arg_t<Is, V>> && ...) &&
+        std::is_nothrow_invocable_r_v<R, Fallback, V>;
+
+    template<class Visitor, class Fallback, class V>
+    static constexpr R apply(Visitor&& vis, Fallback&& fallback, V&& v)  // NOLINT(cppcoreguidelines-missing-std-forward)
+        YK_RVARIANT_VISIT_NOEXCEPT(nothrow<Visitor, Fallback, V>)
+    {
+        static_assert(
+            std::is_invocable_r_v<R, Fallback, V>,
+            "The fallback must be invocable with the variant, and its result must be convertible to the result of the visitor."
+        );
+        std::size_t const i = v.index();
+        if constexpr (use_mask) {
+            if (!((mask >> detail::valueless_bias<Variant>(i)) & 1)) {
+                return std::invoke_r<R>(std::forward<Fallback>(fallback), std::forward<V>(v));
+            }
+        }
+        return visit_some_impl::select<0>(i, std::forward<Visitor>(vis), std::forward<Fallback>(fallback), std::forward<V>(v));
+    }
+
+private:
+    template<std::size_t K, class Visitor, class Fallback, class V>
+    YK_FORCEINLINE static constexpr R select(std::size_t const i, Visitor&& vis, [[maybe_unused]] Fallback&& fallback, V&& v)  // NOLINT(cppcoreguidelines-missing-std-forward)
+        YK_RVARIANT_VISIT_NOEXCEPT(nothrow<Visitor, Fallback, V>)
+    {
+        constexpr std::size_t I = core::npack_indexing_v<K, Is...>;
+        if constexpr (use_mask && K + 1 == sizeof...(Is)) {
+            // the mask test has already excluded the other alternatives
+            return visit_some_impl::invoke<I>(std::forward<Visitor>(vis), std::forward<V>(v));
+
+        } else {
+            if (i == I) {
+                return visit_some_impl::invoke<I>(std::forward<Visitor>(vis), std::forward<V>(v));
+            }
+            if constexpr (K + 1 < sizeof...(Is)) {
+                return visit_some_impl::select<K + 1>(i, std::forward<Visitor>(vis), std::forward<Fallback>(fallback), std::forward<V>(v));
+            } else {
+                return std::invoke_r<R>(std::forward<Fallback>(fallback), std::forward<V>(v));
+            }
+        }
+    }
+
+    template<std::size_t I, class Visitor, class V>
+    YK_FORCEINLINE static constexpr R invoke(Visitor&& vis, V&& v)  // NOLINT(cppcoreguidelines-missing-std-forward)
+        YK_RVARIANT_VISIT_NOEXCEPT(std::is_nothrow_invocable_r_v<R, Visitor, arg_t<I, V>>)
+    {
+        return std::invoke_r<R>(
+            std::forward<Visitor>(vis),
+            unwrap_recursive(detail::raw_get<I>(forward_storage<as_variant_t<V>>(v)))
+        );
+    }
+};
+
+template<class Variant1, class Variant2>
+concept same_variant_as = std::same_as<
+    std::remove_cvref_t<as_variant_t<Variant1>>,
+    std::remove_cvref_t<as_variant_t<Variant2>>
+>;
+
 } // detail
 
 
@@ -673,6 +913,193 @@ YK_FORCEINLINE constexpr R visit(Visitor&& vis, Variants&&... vars)
     >::apply(std::forward<Visitor>(vis), std::forward<Variants>(vars)...);
 }
 
+
+// Visits two variants of the same type with a visitor whose result does not
+// depend on the order of its arguments. The visitor is instantiated only for
+// the pairs of alternatives `(Ti, Tj)` with `i <= j`; if `a.index() > b.index()`,
+// it is called as `vis(b_alternative, a_alternative)`. If `a` and `b` differ
+// in cv or value category, both are passed as their common reference type.
+template<
+    class Visitor,
+    class Variant1,
+    class Variant2,
+    class = std::void_t<detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>
+>
+    requires detail::same_variant_as<Variant1, Variant2>
+YK_FORCEINLINE constexpr detail::visit_result_t<
+    Visitor,
+    detail::visit_commutative_variant_t<Variant1, Variant2>,
+    detail::visit_commutative_variant_t<Variant1, Variant2>
+>
+visit_commutative(Visitor&& vis, Variant1&& a, Variant2&& b)
+    YK_RVARIANT_VISIT_NOEXCEPT(detail::visit_commutative_impl<
+        detail::visit_result_t<
+            Visitor,
+            detail::visit_commutative_variant_t<Variant1, Variant2>,
+            detail::visit_commutative_variant_t<Variant1, Variant2>
+        >,
+        detail::visit_commutative_variant_t<Variant1, Variant2>
+    >::template nothrow<Visitor>)
+{
+    using V = detail::visit_commutative_variant_t<Variant1, Variant2>;
+    using T0R = detail::visit_result_t<Visitor, V, V>;
+    using Impl = detail::visit_commutative_impl<T0R, V>;
+    using Check = detail::visit_seq_check<T0R, Visitor, typename Impl::CheckSeq, V, V>;
+    static_assert(
+        Check::accepts_all_alternatives,
+        "The Visitor must accept all pairs of alternative types `(Ti, Tj)` with `i <= j`."
+    );
+    static_assert(
+        Check::same_return_type,
+        "The Visitor must return the same type and value category "
+        "for all pairs of alternative types `(Ti, Tj)` with `i <= j`."
+    );
+    return Impl::apply(std::forward<Visitor>(vis), std::forward<Variant1>(a), std::forward<Variant2>(b));
+}
+
+template<
+    class R,
+    class Visitor,
+    class Variant1,
+    class Variant2,
+    class = std::void_t<detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>
+>
+    requires detail::same_variant_as<Variant1, Variant2>
+YK_FORCEINLINE constexpr R visit_commutative(Visitor&& vis, Variant1&& a, Variant2&& b)
+    YK_RVARIANT_VISIT_NOEXCEPT(detail::visit_commutative_impl<
+        R,
+        detail::visit_commutative_variant_t<Variant1, Variant2>
+    >::template nothrow<Visitor>)
+{
+    using V = detail::visit_commutative_variant_t<Variant1, Variant2>;
+    using Impl = detail::visit_commutative_impl<R, V>;
+    using Check = detail::visit_R_seq_check<R, Visitor, typename Impl::CheckSeq, V, V>;
+    static_assert(
+        Check::accepts_all_alternatives,
+        "The Visitor must accept all pairs of alternative types `(Ti, Tj)` with `i <= j`."
+    );
+    static_assert(
+        Check::return_type_convertible_to_R,
+        "Each return type of the Visitor must be implicitly convertible to `R`."
+    );
+    return Impl::apply(std::forward<Visitor>(vis), std::forward<Variant1>(a), std::forward<Variant2>(b));
+}
+
+
+// Visits two variants of the same type that are expected to hold the same
+// alternative. The visitor is instantiated only for the pairs `(Ti, Ti)`;
+// if `a.index() != b.index()`, `mismatch(a, b)` is called instead.
+template<
+    class Visitor,
+    class Mismatch,
+    class Variant1,
+    class Variant2,
+    class = std::void_t<detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>
+>
+    requires detail::same_variant_as<Variant1, Variant2>
+YK_FORCEINLINE constexpr detail::visit_result_t<Visitor, detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>
+visit_same(Visitor&& vis, Mismatch&& mismatch, Variant1&& a, Variant2&& b)
+    YK_RVARIANT_VISIT_NOEXCEPT(detail::visit_same_impl<
+        detail::visit_result_t<Visitor, detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>,
+        std::remove_cvref_t<detail::as_variant_t<Variant1>>
+    >::template nothrow<Visitor, Mismatch, Variant1, Variant2>)
+{
+    using T0R = detail::visit_result_t<Visitor, detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>;
+    using Impl = detail::visit_same_impl<T0R, std::remove_cvref_t<detail::as_variant_t<Variant1>>>;
+    using Check = detail::visit_seq_check<T0R, Visitor, typename Impl::CheckSeq, detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>;
+    static_assert(
+        Check::accepts_all_alternatives,
+        "The Visitor must accept all pairs of the same alternative type `(Ti, Ti)`."
+    );
+    static_assert(
+        Check::same_return_type,
+        "The Visitor must return the same type and value category "
+        "for all pairs of the same alternative type `(Ti, Ti)`."
+    );
+    return Impl::apply(std::forward<Visitor>(vis), std::forward<Mismatch>(mismatch), std::forward<Variant1>(a), std::forward<Variant2>(b));
+}
+
+template<
+    class R,
+    class Visitor,
+    class Mismatch,
+    class Variant1,
+    class Variant2,
+    class = std::void_t<detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>
+>
+    requires detail::same_variant_as<Variant1, Variant2>
+YK_FORCEINLINE constexpr R visit_same(Visitor&& vis, Mismatch&& mismatch, Variant1&& a, Variant2&& b)
+    YK_RVARIANT_VISIT_NOEXCEPT(detail::visit_same_impl<
+        R,
+        std::remove_cvref_t<detail::as_variant_t<Variant1>>
+    >::template nothrow<Visitor, Mismatch, Variant1, Variant2>)
+{
+    using Impl = detail::visit_same_impl<R, std::remove_cvref_t<detail::as_variant_t<Variant1>>>;
+    using Check = detail::visit_R_seq_check<R, Visitor, typename Impl::CheckSeq, detail::as_variant_t<Variant1>, detail::as_variant_t<Variant2>>;
+    static_assert(
+        Check::accepts_all_alternatives,
+        "The Visitor must accept all pairs of the same alternative type `(Ti, Ti)`."
+    );
+    static_assert(
+        Check::return_type_convertible_to_R,
+        "Each return type of the Visitor must be implicitly convertible to `R`."
+    );
+    return Impl::apply(std::forward<Visitor>(vis), std::forward<Mismatch>(mismatch), std::forward<Variant1>(a), std::forward<Variant2>(b));
+}
+
+
+// Visits only the alternatives at the indices `Is...`; every other
+// alternative (and the valueless state) is passed to `fallback(v)`.
+template<
+    std::size_t... Is,
+    class Variant,
+    class Visitor,
+    class Fallback,
+    class = std::void_t<detail::as_variant_t<Variant>>
+>
+    requires (sizeof...(Is) > 0)
+YK_FORCEINLINE constexpr detail::visit_some_result_t<core::npack_indexing_v<0, Is...>, Visitor, detail::as_variant_t<Variant>>
+visit_some(Variant&& v, Visitor&& vis, Fallback&& fallback)
+    YK_RVARIANT_VISIT_NOEXCEPT(detail::visit_some_impl<
+        detail::visit_some_result_t<core::npack_indexing_v<0, Is...>, Visitor, detail::as_variant_t<Variant>>,
+        std::remove_cvref_t<detail::as_variant_t<Variant>>,
+        Is...
+    >::template nothrow<Visitor, Fallback, Variant>)
+{
+    using T0R = detail::visit_some_result_t<core::npack_indexing_v<0, Is...>, Visitor, detail::as_variant_t<Variant>>;
+    using Impl = detail::visit_some_impl<T0R, std::remove_cvref_t<detail::as_variant_t<Variant>>, Is...>;
+    using Check = detail::visit_seq_check<T0R, Visitor, typename Impl::CheckSeq, detail::as_variant_t<Variant>>;
+    static_assert(
+        Check::accepts_all_alternatives,
+        "The Visitor must accept all selected alternative types."
+    );
+    static_assert(
+        Check::same_return_type,
+        "The Visitor must return the same type and value category for all selected alternative types."
+    );
+    return Impl::apply(std::forward<Visitor>(vis), std::forward<Fallback>(fallback), std::forward<Variant>(v));
+}
+
+// Equivalent to `visit_some<I...>(v, vis, fallback)`, where each `I` is the
+// index of `T` or `recursive_wrapper<T>`
+template<
+    class... Ts,
+    class Variant,
+    class Visitor,
+    class Fallback,
+    class = std::void_t<detail::as_variant_t<Variant>>
+>
+    requires (sizeof...(Ts) > 0)
+YK_FORCEINLINE constexpr decltype(auto) visit_some(Variant&& v, Visitor&& vis, Fallback&& fallback)
+    YK_RVARIANT_VISIT_NOEXCEPT(noexcept(yk::visit_some<detail::exactly_once_index_v<Ts, std::remove_cvref_t<detail::as_variant_t<Variant>>>...>(
+        std::forward<Variant>(v), std::forward<Visitor>(vis), std::forward<Fallback>(fallback)
+    )))
+{
+    return yk::visit_some<detail::exactly_once_index_v<Ts, std::remove_cvref_t<detail::as_variant_t<Variant>>>...>(
+        std::forward<Variant>(v), std::forward<Visitor>(vis), std::forward<Fallback>(fallback)
+    );
+}
+
 } // yk
 
 #endif
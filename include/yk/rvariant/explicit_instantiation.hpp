@@ -0,0 +1,40 @@
+﻿#ifndef YK_RVARIANT_EXPLICIT_INSTANTIATION_HPP
+#define YK_RVARIANT_EXPLICIT_INSTANTIATION_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <yk/rvariant/rvariant.hpp>
+
+// Explicit instantiation of the non-inline operations of `rvariant<Ts...>`;
+// i.e. `std::hash` and, with the `_IO` variants, `operator<<`. Each is
+// instantiated only if it is available for `Ts...`.
+//
+//   // ast.hpp; after all alternatives are complete
+//   YK_RVARIANT_EXTERN_TEMPLATE(int, std::string, yk::recursive_wrapper<Binary>);
+//
+//   // ast.cpp; in exactly one translation unit
+//   YK_RVARIANT_INSTANTIATE(int, std::string, yk::recursive_wrapper<Binary>);
+//
+// Both shall appear in the global namespace or in namespace `yk`.
+//
+// NOTE: an explicit instantiation declaration does not suppress the implicit
+// instantiation of inline functions ([temp.explicit]). The special member
+// functions and the comparison operators are `constexpr`, thus inline, and
+// are not covered.
+
+#define YK_RVARIANT_EXTERN_TEMPLATE(...) \
+    extern template struct ::yk::detail::rvariant_ops<__VA_ARGS__>
+
+#define YK_RVARIANT_INSTANTIATE(...) \
+    template struct ::yk::detail::rvariant_ops<__VA_ARGS__>
+
+// `operator<<`; requires <yk/rvariant/rvariant_io.hpp>
+#define YK_RVARIANT_EXTERN_TEMPLATE_IO(...) \
+    extern template struct ::yk::detail::rvariant_io_ops<__VA_ARGS__>
+
+#define YK_RVARIANT_INSTANTIATE_IO(...) \
+    template struct ::yk::detail::rvariant_io_ops<__VA_ARGS__>
+
+#endif
@@ -0,0 +1,258 @@
+﻿#ifndef YK_RVARIANT_MAILBOX_HPP
+#define YK_RVARIANT_MAILBOX_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Bounded lock-free multi-producer single-consumer queue of rvariant messages
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/core/type_traits.hpp>
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cstddef>
+
+namespace yk {
+
+namespace detail {
+
+// Not `std::hardware_destructive_interference_size`; its value may differ
+// across translation units compiled with different flags.
+inline constexpr std::size_t mailbox_cache_line_size = 64;
+
+} // detail
+
+// Based on Dmitry Vyukov's bounded MPMC queue, specialized for a single
+// consumer. Each message is constructed directly in its slot and visited
+// in place; no message is moved through the queue.
+template<class Variant>
+class mailbox
+{
+    static_assert(core::is_ttp_specialization_of_v<Variant, rvariant>);
+
+    struct cell
+    {
+        std::atomic<std::size_t> sequence;
+        bool engaged; // false if the construction of the message has thrown
+        bool consumed; // visited by a `drain_grouped` that has thrown, but not yet released
+        alignas(Variant) unsigned char storage[sizeof(Variant)];
+
+        [[nodiscard]] Variant& message() noexcept
+        {
+            return *std::launder(reinterpret_cast<Variant*>(storage));
+        }
+    };
+
+public:
+    // The capacity is rounded up to a power of two
+    explicit mailbox(std::size_t const capacity)
+        : mask_(std::bit_ceil(capacity < 2 ? 2 : capacity) - 1)
+        , cells_(std::make_unique<cell[]>(mask_ + 1))
+    {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        batch_.reserve(mask_ + 1);
+        grouped_.resize(mask_ + 1);
+    }
+
+    mailbox(mailbox const&) = delete;
+    mailbox& operator=(mailbox const&) = delete;
+
+    ~mailbox()
+    {
+        (void)this->drain([](auto&&) noexcept {});
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Producer side; may be called concurrently. Returns `false` if the mailbox is full.
+    template<std::size_t I, class... Args>
+        requires std::is_constructible_v<Variant, std::in_place_index_t<I>, Args...>
+    [[nodiscard]] bool try_emplace(Args&&... args)
+    {
+        cell* const c = this->acquire_cell();
+        if (!c) return false;
+
+        struct publish_guard
+        {
+            cell* c;
+            std::size_t sequence;
+            ~publish_guard() { c->sequence.store(sequence, std::memory_order_release); }
+        } const guard{c, c->sequence.load(std::memory_order_relaxed) + 1};
+
+        c->engaged = false;
+        c->consumed = false;
+        std::construct_at(reinterpret_cast<Variant*>(c->storage), std::in_place_index<I>, std::forward<Args>(args)...);
+        c->engaged = true;
+        return true;
+    }
+
+    template<class T, class... Args>
+        requires std::is_constructible_v<Variant, std::in_place_type_t<T>, Args...>
+    [[nodiscard]] bool try_emplace(Args&&... args)
+    {
+        constexpr std::size_t I = detail::exactly_once_index_v<T, Variant>;
+        return this->template try_emplace<I>(std::forward<Args>(args)...);
+    }
+
+    // Consumer side; shall not be called concurrently with itself.
+    // Visits at most `max` messages in the order of acquisition, and
+    // returns the number of messages consumed.
+    template<class Visitor>
+    std::size_t drain(Visitor&& vis, std::size_t const max = static_cast<std::size_t>(-1))
+    {
+        std::size_t n = 0;
+        while (n < max) {
+            cell* const c = this->ready_cell(dequeue_pos_);
+            if (!c) break;
+
+            release_guard const guard{this, c};
+            if (c->consumed) continue;
+            ++n;
+            if (c->engaged) {
+                yk::visit(vis, c->message());
+            }
+        }
+        return n;
+    }
+
+    // Same as `drain`, except that a batch of messages is visited grouped by
+    // the index of the alternative, in ascending order of the index. The
+    // order of acquisition is preserved within each group.
+    template<class Visitor>
+    std::size_t drain_grouped(Visitor&& vis, std::size_t max = static_cast<std::size_t>(-1))
+    {
+        constexpr std::size_t N = variant_size_v<Variant>;
+        if (max > mask_ + 1) max = mask_ + 1;
+
+        // Cells already consumed by a previous call are released, but neither
+        // visited nor counted
+        batch_.clear();
+        std::size_t n = 0;
+        for (std::size_t pos = dequeue_pos_; n < max; ++pos) {
+            cell* const c = this->ready_cell(pos);
+            if (!c) break;
+            batch_.push_back(c);
+            if (!c->consumed) ++n;
+        }
+        if (batch_.empty()) return 0;
+
+        // Cells are released in the order of acquisition, but visited out of
+        // that order. If the visitor throws, the cells visited so far (including
+        // the one that threw) are consumed and the leading run of consumed cells
+        // is released; the rest are left for the next drain.
+        struct batch_guard
+        {
+            mailbox* self;
+            std::size_t visited = 0;
+            ~batch_guard()
+            {
+                for (std::size_t k = 0; k < visited; ++k) {
+                    cell* const c = self->grouped_[k];
+                    if (c->engaged) {
+                        std::destroy_at(&c->message());
+                        c->engaged = false;
+                    }
+                    c->consumed = true;
+                }
+                for (cell* const c : self->batch_) {
+                    if (!c->consumed) break;
+                    self->release(c);
+                }
+            }
+        } guard{this};
+
+        std::size_t heads[N + 1]{};
+        for (cell* const c : batch_) {
+            if (!c->consumed) ++heads[this->group_of(c)];
+        }
+        for (std::size_t b = 0, sum = 0; b <= N; ++b) {
+            sum += std::exchange(heads[b], sum);
+        }
+        for (cell* const c : batch_) {
+            if (!c->consumed) grouped_[heads[this->group_of(c)]++] = c;
+        }
+
+        while (guard.visited < n) {
+            cell* const c = grouped_[guard.visited++];
+            if (c->engaged) {
+                yk::visit(vis, c->message());
+            }
+        }
+        return n;
+    }
+
+private:
+    struct release_guard
+    {
+        mailbox* self;
+        cell* c;
+        ~release_guard() { self->release(c); }
+    };
+
+    [[nodiscard]] cell* acquire_cell() noexcept
+    {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell* const c = &cells_[pos & mask_];
+            std::size_t const sequence = c->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return c;
+                }
+            } else if (diff < 0) {
+                return nullptr; // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] cell* ready_cell(std::size_t const pos) noexcept
+    {
+        cell* const c = &cells_[pos & mask_];
+        return c->sequence.load(std::memory_order_acquire) == pos + 1 ? c : nullptr;
+    }
+
+    [[nodiscard]] std::size_t group_of(cell* const c) noexcept
+    {
+        constexpr std::size_t N = variant_size_v<Variant>;
+        if (!c->engaged) return N;
+        std::size_t const i = c->message().index();
+        return i < N ? i : N;
+    }
+
+    // Cells are released in the order of acquisition
+    void release(cell* const c) noexcept
+    {
+        if (c->engaged) {
+            std::destroy_at(&c->message());
+        }
+        c->sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+    }
+
+    std::size_t mask_;
+    std::unique_ptr<cell[]> cells_;
+
+    alignas(detail::mailbox_cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+
+    // consumer only
+    alignas(detail::mailbox_cache_line_size) std::size_t dequeue_pos_ = 0;
+    std::vector<cell*> batch_, grouped_;
+};
+
+} // yk
+
+#endif
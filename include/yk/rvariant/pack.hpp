@@ -10,42 +10,72 @@
 
 #include <yk/core/type_traits.hpp>
 
+#include <initializer_list>
+#include <utility>
+
+#include <cstddef>
+
 namespace yk {
 
 namespace detail {
 
-template<template<class...> class TT, class T, class... Us>
-struct pack_union_impl;
+// The indices of the first occurrence of each distinct type in Us...,
+// in ascending order. Computed in a single constant evaluation so that
+// the number of instantiations is linear in sizeof...(Us).
+template<class... Us>
+struct pack_dedup_indices
+{
+    template<class U>
+    static constexpr std::size_t first_index = core::detail::find_first_true({YK_CORE_IS_SAME(U, Us)...});
+
+    struct indices_type
+    {
+        std::size_t size = 0;
+        std::size_t data[sizeof...(Us) + 1]{};
+    };
+
+    static constexpr indices_type make() noexcept
+    {
+        indices_type res;
+        std::size_t i = 0;
+        for (std::size_t const first : std::initializer_list<std::size_t>{first_index<Us>...}) {
+            if (first == i) res.data[res.size++] = i;
+            ++i;
+        }
+        return res;
+    }
+
+    static constexpr indices_type value = make();
+};
+
+template<template<class...> class TT, class Js, class... Us>
+struct pack_union_select;
 
-template<template<class...> class TT, class... Ts>
-struct pack_union_impl<TT, core::type_list<Ts...>>
+template<template<class...> class TT, std::size_t... Js, class... Us>
+struct pack_union_select<TT, std::index_sequence<Js...>, Us...>
 {
-    using type = TT<Ts...>;
+    using type = TT<core::pack_indexing_t<pack_dedup_indices<Us...>::value.data[Js], Us...>...>;
 };
 
-template<template<class...> class TT, class... Ts, class U, class... Us>
-struct pack_union_impl<TT, core::type_list<Ts...>, U, Us...>
-    : std::conditional_t<
-    core::is_in_v<U, Ts...>,
-        pack_union_impl<TT, core::type_list<Ts...>, Us...>,
-        pack_union_impl<TT, core::type_list<Ts..., U>, Us...>
-    >
+template<template<class...> class TT, class... Us>
+struct pack_union_impl
+    : pack_union_select<TT, std::make_index_sequence<pack_dedup_indices<Us...>::value.size>, Us...>
 {};
 
 template<template<class...> class TT, class A, class B>
 struct pack_union;
 
 template<template<class...> class TT, class A, class B>
-struct pack_union : detail::pack_union_impl<TT, core::type_list<>, A, B> {};
+struct pack_union : detail::pack_union_impl<TT, A, B> {};
 
 template<template<class...> class TT, class... As, class B>
-struct pack_union<TT, TT<As...>, B> : detail::pack_union_impl<TT, core::type_list<>, As..., B> {};
+struct pack_union<TT, TT<As...>, B> : detail::pack_union_impl<TT, As..., B> {};
 
 template<template<class...> class TT, class A, class... Bs>
-struct pack_union<TT, A, TT<Bs...>> : detail::pack_union_impl<TT, core::type_list<>, A, Bs...> {};
+struct pack_union<TT, A, TT<Bs...>> : detail::pack_union_impl<TT, A, Bs...> {};
 
 template<template<class...> class TT, class... As, class... Bs>
-struct pack_union<TT, TT<As...>, TT<Bs...>> : detail::pack_union_impl<TT, core::type_list<>, As..., Bs...> {};
+struct pack_union<TT, TT<As...>, TT<Bs...>> : detail::pack_union_impl<TT, As..., Bs...> {};
 
 template<template<class...> class TT, class A, class B>
 using pack_union_t = typename pack_union<TT, A, B>::type;
@@ -0,0 +1,275 @@
+﻿#ifndef YK_RVARIANT_PARALLEL_TREE_HPP
+#define YK_RVARIANT_PARALLEL_TREE_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Parallel deep copy and destruction of recursive rvariant trees
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/rvariant/recursive_wrapper.hpp>
+#include <yk/core/type_traits.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cstddef>
+
+namespace yk {
+
+namespace detail {
+
+// A node whose children are split into separate tasks: a sized sequence of
+// `Variant` which can be created with its final number of (default) children.
+template<class T, class Variant>
+concept tree_sequence_node =
+    std::ranges::forward_range<T> &&
+    std::ranges::sized_range<T> &&
+    std::same_as<std::ranges::range_value_t<T>, Variant> &&
+    std::constructible_from<T, std::ranges::range_size_t<T>>;
+
+template<class Alt, class Variant>
+struct is_tree_split_point : std::false_type {};
+
+template<class T, class Allocator, class Variant>
+struct is_tree_split_point<recursive_wrapper<T, Allocator>, Variant>
+    : std::bool_constant<tree_sequence_node<T, Variant>>
+{};
+
+template<class Variant>
+struct tree_split_points;
+
+template<class... Ts>
+struct tree_split_points<rvariant<Ts...>>
+{
+    static constexpr bool table[] = {is_tree_split_point<Ts, rvariant<Ts...>>::value...};
+
+    [[nodiscard]] static constexpr bool holds_split_point(rvariant<Ts...> const& v) noexcept
+    {
+        std::size_t const i = v.index();
+        return i < sizeof...(Ts) && table[i];
+    }
+};
+
+inline constexpr std::size_t tree_task_cache_line_size = 64;
+
+// Each worker pushes to and pops from the back of its own queue, and steals
+// from the front of the others'. A worker whose queue is full processes the
+// task inline instead, which bounds the memory and coarsens the tasks once
+// every worker is busy.
+template<class Task>
+class tree_task_pool
+{
+public:
+    static constexpr std::size_t queue_limit = 64;
+
+    explicit tree_task_pool(std::size_t const thread_count)
+        : queues_(std::max<std::size_t>(thread_count, 1))
+    {}
+
+    // Calls `work(task, spawn)` for `root` and every task spawned from it.
+    // `spawn(Task&&)` never throws; it returns `false` (leaving the argument
+    // untouched) if the task was not accepted and should be processed by
+    // the caller.
+    template<class Work>
+    void run(Task root, Work const& work)
+    {
+        pending_.store(1, std::memory_order_relaxed);
+        queues_[0].tasks.push_back(std::move(root));
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(queues_.size() - 1);
+            for (std::size_t k = 1; k < queues_.size(); ++k) {
+                threads.emplace_back([this, k, &work] { this->worker(k, work); });
+            }
+            this->worker(0, work);
+        }
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    struct alignas(tree_task_cache_line_size) queue
+    {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    template<class Work>
+    void worker(std::size_t const k, Work const& work)
+    {
+        auto const spawn = [this, k](Task&& task) noexcept -> bool {
+            queue& q = queues_[k];
+            std::lock_guard lock(q.mtx);
+            if (q.tasks.size() >= queue_limit) return false;
+            try {
+                q.tasks.push_back(std::move(task));
+            } catch (...) {
+                return false; // strong guarantee; `task` is intact
+            }
+            // The spawning task is still pending, so the count never drops to
+            // zero before this increment.
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        };
+
+        for (;;) {
+            std::optional<Task> task = this->take(k);
+            if (!task) {
+                if (pending_.load(std::memory_order_acquire) == 0) return;
+                std::this_thread::yield();
+                continue;
+            }
+            if (!stopped_.load(std::memory_order_relaxed)) {
+                try {
+                    work(*task, spawn);
+                } catch (...) {
+                    std::lock_guard lock(error_mtx_);
+                    if (!error_) error_ = std::current_exception();
+                    stopped_.store(true, std::memory_order_relaxed);
+                }
+            }
+            task.reset();
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    [[nodiscard]] std::optional<Task> take(std::size_t const k)
+    {
+        {
+            queue& q = queues_[k];
+            std::lock_guard lock(q.mtx);
+            if (!q.tasks.empty()) {
+                std::optional<Task> task(std::move(q.tasks.back()));
+                q.tasks.pop_back();
+                return task;
+            }
+        }
+        for (std::size_t d = 1; d < queues_.size(); ++d) {
+            queue& q = queues_[(k + d) % queues_.size()];
+            std::lock_guard lock(q.mtx);
+            if (!q.tasks.empty()) {
+                std::optional<Task> task(std::move(q.tasks.front()));
+                q.tasks.pop_front();
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::vector<queue> queues_;
+    alignas(tree_task_cache_line_size) std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> stopped_{false};
+    std::mutex error_mtx_;
+    std::exception_ptr error_;
+};
+
+[[nodiscard]] inline std::size_t tree_thread_count(std::size_t const thread_count) noexcept
+{
+    if (thread_count != 0) return thread_count;
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+} // detail
+
+
+// Returns a deep copy of `root`. The tree is split into tasks at each
+// `recursive_wrapper<T, Allocator>` whose `T` is a sequence of `rvariant`
+// (see `detail::tree_sequence_node`); other alternatives are copied as a
+// whole. Each node is allocated with the allocator its wrapper would use
+// on copy construction.
+template<class... Ts>
+[[nodiscard]] rvariant<Ts...> parallel_deep_copy(rvariant<Ts...> const& root, std::size_t const thread_count = 0)
+{
+    using Variant = rvariant<Ts...>;
+    using split_points = detail::tree_split_points<Variant>;
+
+    struct copy_task
+    {
+        Variant* dst;
+        Variant const* src;
+    };
+
+    std::size_t const threads = detail::tree_thread_count(thread_count);
+    if (threads == 1) return root;
+
+    Variant result;
+    detail::tree_task_pool<copy_task> pool(threads);
+    pool.run(copy_task{std::addressof(result), std::addressof(root)}, [](copy_task const& task, auto const& spawn) {
+        detail::raw_visit(*task.src, [&]<std::size_t i, class Alt>(std::in_place_index_t<i>, Alt const& alt) {
+            if constexpr (i != std::variant_npos && detail::is_tree_split_point<Alt, Variant>::value) {
+                if (alt.valueless_after_move()) {
+                    *task.dst = *task.src;
+                    return;
+                }
+                auto const& node = *alt;
+                auto& dst_node = task.dst->template emplace<i>(
+                    std::allocator_arg,
+                    std::allocator_traits<typename Alt::allocator_type>::select_on_container_copy_construction(alt.get_allocator()),
+                    std::in_place,
+                    std::ranges::size(node)
+                );
+                auto it = std::ranges::begin(dst_node);
+                for (Variant const& child : node) {
+                    if (!split_points::holds_split_point(child) || !spawn(copy_task{std::addressof(*it), std::addressof(child)})) {
+                        *it = child;
+                    }
+                    ++it;
+                }
+            } else {
+                (void)alt;
+                *task.dst = *task.src;
+            }
+        });
+    });
+    return result;
+}
+
+// Destroys the tree held by `root`, splitting it into tasks at the same
+// points as `parallel_deep_copy`. `root` is left in a valid but unspecified state.
+template<class... Ts>
+void parallel_destroy(rvariant<Ts...>&& root, std::size_t const thread_count = 0)
+{
+    using Variant = rvariant<Ts...>;
+    using split_points = detail::tree_split_points<Variant>;
+
+    std::size_t const threads = detail::tree_thread_count(thread_count);
+    if (threads == 1) {
+        (void)Variant(std::move(root));
+        return;
+    }
+
+    detail::tree_task_pool<Variant> pool(threads);
+    pool.run(Variant(std::move(root)), [](Variant& task, auto const& spawn) {
+        Variant owned(std::move(task)); // destroyed at the end of this task
+        detail::raw_visit(owned, [&]<std::size_t i, class Alt>(std::in_place_index_t<i>, Alt& alt) {
+            if constexpr (i != std::variant_npos && detail::is_tree_split_point<Alt, Variant>::value) {
+                if (alt.valueless_after_move()) return;
+                for (Variant& child : *alt) {
+                    if (split_points::holds_split_point(child)) {
+                        Variant detached(std::move(child));
+                        (void)spawn(std::move(detached)); // destroyed inline if not accepted
+                    }
+                }
+            } else {
+                (void)alt;
+            }
+        });
+    });
+}
+
+} // yk
+
+#endif
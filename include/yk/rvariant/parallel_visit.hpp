@@ -0,0 +1,298 @@
+﻿#ifndef YK_RVARIANT_PARALLEL_VISIT_HPP
+#define YK_RVARIANT_PARALLEL_VISIT_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Parallel visitation of ranges of rvariant
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/rvariant/algorithm.hpp>
+#include <yk/core/type_traits.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#if __has_include(<execution>)
+# include <execution>
+#endif
+
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201603L
+# define YK_RVARIANT_HAS_EXECUTION_POLICY 1
+#else
+# define YK_RVARIANT_HAS_EXECUTION_POLICY 0
+#endif
+
+namespace yk {
+
+// Runs the work on `threads` `std::jthread`s (the calling thread included);
+// `0` means `std::thread::hardware_concurrency()`.
+struct jthread_policy
+{
+    std::size_t threads = 0;
+};
+
+struct group_by_index_t
+{
+    explicit group_by_index_t() = default;
+};
+
+inline constexpr group_by_index_t group_by_index{};
+
+// Relative cost of visiting each alternative
+template<class Variant>
+using visit_cost_table = std::array<double, variant_size_v<Variant>>;
+
+template<class Policy>
+concept visit_each_policy =
+    std::same_as<std::remove_cvref_t<Policy>, jthread_policy>
+#if YK_RVARIANT_HAS_EXECUTION_POLICY
+    || std::is_execution_policy_v<std::remove_cvref_t<Policy>>
+#endif
+;
+
+namespace detail {
+
+struct visit_chunk
+{
+    std::size_t first, last;
+};
+
+template<class Policy>
+[[nodiscard]] std::size_t visit_each_concurrency(Policy const& policy) noexcept
+{
+    if constexpr (std::same_as<Policy, jthread_policy>) {
+        if (policy.threads != 0) return policy.threads;
+    } else {
+        (void)policy;
+    }
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// Calls `f(chunk)` for each chunk; the chunks are distributed dynamically.
+template<class Policy, class F>
+void for_each_chunk(Policy&& policy, std::vector<visit_chunk> const& chunks, F const& f)
+{
+    if constexpr (std::same_as<std::remove_cvref_t<Policy>, jthread_policy>) {
+        std::size_t const threads = std::min(detail::visit_each_concurrency(policy), chunks.size());
+        std::atomic<std::size_t> cursor{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mtx;
+
+        auto const worker = [&] {
+            for (;;) {
+                std::size_t const c = cursor.fetch_add(1, std::memory_order_relaxed);
+                if (c >= chunks.size() || failed.load(std::memory_order_relaxed)) return;
+                try {
+                    f(chunks[c]);
+                } catch (...) {
+                    std::lock_guard lock(error_mtx);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+        {
+            std::vector<std::jthread> workers;
+            if (threads > 1) workers.reserve(threads - 1);
+            for (std::size_t k = 1; k < threads; ++k) {
+                workers.emplace_back(worker);
+            }
+            worker();
+        }
+        if (error) std::rethrow_exception(error);
+
+    } else {
+#if YK_RVARIANT_HAS_EXECUTION_POLICY
+        std::for_each(std::forward<Policy>(policy), chunks.begin(), chunks.end(), f);
+#endif
+    }
+}
+
+inline constexpr std::size_t visit_each_min_chunk_size = 256;
+inline constexpr std::size_t visit_each_chunks_per_thread = 8;
+inline constexpr std::size_t visit_each_blocks_per_thread = 64;
+inline constexpr std::size_t visit_each_group_window = 4096;
+
+[[nodiscard]] inline std::vector<visit_chunk> make_uniform_chunks(std::size_t const n, std::size_t const count)
+{
+    std::size_t const size = std::max((n + count - 1) / std::max(count, 1uz), visit_each_min_chunk_size);
+    std::vector<visit_chunk> chunks;
+    for (std::size_t first = 0; first < n; first += size) {
+        chunks.push_back({first, std::min(first + size, n)});
+    }
+    return chunks;
+}
+
+// Splits the range into chunks of roughly equal total cost. The cost of each
+// fixed-size block is computed (in parallel) from its index histogram, then
+// consecutive blocks are merged until the target cost is reached.
+template<class Policy, class It, std::size_t N>
+[[nodiscard]] std::vector<visit_chunk> make_cost_aware_chunks(
+    Policy& policy, It const first, std::size_t const n, std::array<double, N> const& costs
+)
+{
+    std::size_t const concurrency = detail::visit_each_concurrency(policy);
+    std::vector<visit_chunk> blocks = detail::make_uniform_chunks(n, concurrency * visit_each_blocks_per_thread);
+    if (blocks.size() <= 1) return blocks;
+
+    std::vector<double> block_cost(blocks.size());
+    detail::for_each_chunk(policy, blocks, [&](visit_chunk const& block) {
+        auto const hist = yk::index_histogram(std::ranges::subrange(
+            first + static_cast<std::iter_difference_t<It>>(block.first),
+            first + static_cast<std::iter_difference_t<It>>(block.last)
+        ));
+        double cost = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            cost += static_cast<double>(hist[i]) * costs[i];
+        }
+        block_cost[static_cast<std::size_t>(&block - blocks.data())] = cost;
+    });
+
+    double total = 0;
+    for (double const c : block_cost) total += c;
+    double const target = total / static_cast<double>(concurrency * visit_each_chunks_per_thread);
+
+    std::vector<visit_chunk> chunks;
+    double acc = 0;
+    std::size_t chunk_first = 0;
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+        acc += block_cost[b];
+        if (acc >= target || b + 1 == blocks.size()) {
+            chunks.push_back({chunk_first, blocks[b].last});
+            chunk_first = blocks[b].last;
+            acc = 0;
+        }
+    }
+    return chunks;
+}
+
+// Visits the elements of the window grouped by the index, so that the
+// visitor is called with a statically known alternative in a tight loop.
+// `positions` shall have room for `n` elements; it is allocated by the
+// caller so that this function neither allocates nor synchronizes, which
+// is required for `std::execution::par_unseq`.
+template<class Variant, class It, class Visitor>
+void visit_window_grouped(It const first, std::size_t const n, std::uint32_t* const positions, Visitor& vis)
+{
+    constexpr std::size_t N = variant_size_v<Variant>;
+
+    std::array<std::size_t, N + 1> heads{};
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t const i = first[static_cast<std::iter_difference_t<It>>(k)].index();
+        if (i >= N) detail::throw_bad_variant_access();
+        ++heads[i + 1];
+    }
+    for (std::size_t i = 1; i <= N; ++i) heads[i] += heads[i - 1];
+    std::array<std::size_t, N + 1> const bounds = heads;
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t const i = first[static_cast<std::iter_difference_t<It>>(k)].index();
+        positions[heads[i]++] = static_cast<std::uint32_t>(k);
+    }
+
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ([&] {
+            for (std::size_t p = bounds[I]; p < bounds[I + 1]; ++p) {
+                std::invoke(vis, yk::get<I>(first[static_cast<std::iter_difference_t<It>>(positions[p])]));
+            }
+        }(), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+template<class Policy, class R, class Visitor>
+void visit_each_impl(
+    Policy&& policy, bool const grouped, R&& r, Visitor& vis,
+    visit_cost_table<std::ranges::range_value_t<R>> const* const costs
+)
+{
+    using Variant = std::ranges::range_value_t<R>;
+    auto const first = std::ranges::begin(r);
+    std::size_t const n = static_cast<std::size_t>(std::ranges::size(r));
+    if (n == 0) return;
+
+    std::vector<visit_chunk> const chunks = costs
+        ? detail::make_cost_aware_chunks(policy, first, n, *costs)
+        : detail::make_uniform_chunks(n, detail::visit_each_concurrency(policy) * visit_each_chunks_per_thread);
+
+    // One slot per element; each window uses its own disjoint part
+    std::vector<std::uint32_t> positions(grouped ? n : 0);
+
+    detail::for_each_chunk(std::forward<Policy>(policy), chunks, [&](visit_chunk const& chunk) {
+        if (grouped) {
+            for (std::size_t k = chunk.first; k < chunk.last; k += visit_each_group_window) {
+                detail::visit_window_grouped<Variant>(
+                    first + static_cast<std::ranges::range_difference_t<R>>(k),
+                    std::min(visit_each_group_window, chunk.last - k),
+                    positions.data() + k,
+                    vis
+                );
+            }
+        } else {
+            for (std::size_t k = chunk.first; k < chunk.last; ++k) {
+                yk::visit(vis, first[static_cast<std::ranges::range_difference_t<R>>(k)]);
+            }
+        }
+    });
+}
+
+template<class R>
+concept visit_each_range =
+    std::ranges::random_access_range<R> &&
+    std::ranges::sized_range<R> &&
+    core::is_ttp_specialization_of_v<std::ranges::range_value_t<R>, rvariant>;
+
+} // detail
+
+
+// Calls `yk::visit(vis, e)` for each element `e` of `r`, in parallel. `vis`
+// may be called concurrently from multiple threads.
+template<class Policy, class R, class Visitor>
+    requires visit_each_policy<Policy> && detail::visit_each_range<R>
+void visit_each(Policy&& policy, R&& r, Visitor&& vis)
+{
+    detail::visit_each_impl(std::forward<Policy>(policy), false, r, vis, nullptr);
+}
+
+template<class Policy, class R, class Visitor>
+    requires visit_each_policy<Policy> && detail::visit_each_range<R>
+void visit_each(Policy&& policy, R&& r, Visitor&& vis, visit_cost_table<std::ranges::range_value_t<R>> const& costs)
+{
+    detail::visit_each_impl(std::forward<Policy>(policy), false, r, vis, &costs);
+}
+
+// Same as above, except that the elements of each chunk are visited
+// grouped by the index of the alternative.
+template<class Policy, class R, class Visitor>
+    requires visit_each_policy<Policy> && detail::visit_each_range<R>
+void visit_each(Policy&& policy, group_by_index_t, R&& r, Visitor&& vis)
+{
+    detail::visit_each_impl(std::forward<Policy>(policy), true, r, vis, nullptr);
+}
+
+template<class Policy, class R, class Visitor>
+    requires visit_each_policy<Policy> && detail::visit_each_range<R>
+void visit_each(Policy&& policy, group_by_index_t, R&& r, Visitor&& vis, visit_cost_table<std::ranges::range_value_t<R>> const& costs)
+{
+    detail::visit_each_impl(std::forward<Policy>(policy), true, r, vis, &costs);
+}
+
+} // yk
+
+#endif
@@ -20,6 +20,7 @@
 #include <yk/core/hash.hpp>
 
 #include <yk/hash.hpp>
+#include <yk/for_overwrite.hpp>
 
 #include <functional>
 #include <initializer_list>
@@ -29,6 +30,7 @@
 #include <memory>
 
 #include <cstddef>
+#include <cstring>
 #include <cassert>
 
 namespace yk {
@@ -38,6 +40,9 @@ namespace detail {
 template<class Compare, class... Ts>
 struct relops_visitor;
 
+template<class Variant>
+struct index_access;
+
 template<class... Ts>
 struct rvariant_base
 {
@@ -47,6 +52,8 @@ private:
 protected:
     using storage_type = make_variadic_union_t<Ts...>;
     static constexpr bool never_valueless = storage_type::never_valueless;
+    static constexpr std::size_t never_valueless_size_limit = rvariant_policy_traits<Ts...>::never_valueless_trivial_size_limit;
+    static constexpr bool nothrow_move_never_valueless = rvariant_policy_traits<Ts...>::nothrow_move_never_valueless;
 
     template<class Self>
     using like_rvariant_t = std::conditional_t<
@@ -75,7 +82,15 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
     constexpr explicit rvariant_base(std::in_place_index_t<I>, Args&&... args)
         noexcept(std::is_nothrow_constructible_v<core::pack_indexing_t<I, Ts...>, Args...>)
         : storage_(std::in_place_index<I>, std::forward<Args>(args)...)
-        , index_{static_cast<variant_index_t<sizeof...(Ts)>>(I)}
+        , index_{static_cast<rvariant_index_t<Ts...>>(I)}
+    {}
+
+    template<std::size_t I, class F>
+        requires is_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value
+    constexpr explicit rvariant_base(std::in_place_index_t<I>, from_invoke_t, F&& f)
+        noexcept(is_nothrow_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value)
+        : storage_(std::in_place_index<I>, from_invoke, std::forward<F>(f))
+        , index_{static_cast<rvariant_index_t<Ts...>>(I)}
     {}
 YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
 
@@ -84,6 +99,20 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
         : storage_{} // valueless
     {}
 
+    // Primary constructor called from derived class
+    constexpr explicit rvariant_base(for_overwrite_t) noexcept
+        : storage_{} // no active member
+        , index_{0}
+    {
+        using T = core::pack_indexing_t<0, Ts...>;
+        static_assert(std::is_trivially_default_constructible_v<T>);
+        if consteval {
+            std::construct_at(&storage_, std::in_place_index<0>); // indeterminate values are not allowed in constant evaluation
+        } else {
+            ::new (static_cast<void*>(std::addressof(raw_get<0>(storage_)))) T; // default-initialize; writes nothing
+        }
+    }
+
     // Copy constructor
     constexpr void _copy_construct(rvariant_base const& w)
         noexcept(std::conjunction_v<std::is_nothrow_copy_constructible<Ts>...>)
@@ -181,13 +210,20 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
     [[nodiscard]] constexpr bool valueless_by_exception() const noexcept
     {
         if constexpr (never_valueless) {
-            assert(index_ != detail::variant_npos<sizeof...(Ts)>);
+            assert(index_ != detail::rvariant_npos<Ts...>);
             return false;
         } else {
-            return index_ == detail::variant_npos<sizeof...(Ts)>;
+            return index_ == detail::rvariant_npos<Ts...>;
         }
     }
-    [[nodiscard]] constexpr std::size_t index() const noexcept { return static_cast<std::size_t>(index_); }
+    [[nodiscard]] constexpr std::size_t index() const noexcept
+    {
+        if constexpr (!never_valueless && std::is_unsigned_v<rvariant_index_t<Ts...>>) {
+            // unsigned npos does not convert to `std::variant_npos`
+            if (index_ == rvariant_npos<Ts...>) return std::variant_npos;
+        }
+        return static_cast<std::size_t>(index_);
+    }
 
     // internal
     template<std::size_t I>
@@ -220,11 +256,11 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
             this->raw_visit([this]<std::size_t i, class T>(std::in_place_index_t<i>, [[maybe_unused]] T& alt) noexcept {
                 if constexpr (i != std::variant_npos) {
                     alt.~T();
-                    index_ = variant_npos<sizeof...(Ts)>;
+                    index_ = rvariant_npos<Ts...>;
                 }
             });
         } else {
-            index_ = variant_npos<sizeof...(Ts)>;
+            index_ = rvariant_npos<Ts...>;
         }
     }
     // internal
@@ -237,7 +273,7 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
             using T = core::pack_indexing_t<I, Ts...>;
             auto&& alt = raw_get<I>(storage_);
             alt.~T();
-            index_ = variant_npos<sizeof...(Ts)>;
+            index_ = rvariant_npos<Ts...>;
         }
     }
 
@@ -247,9 +283,9 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         noexcept(std::is_nothrow_constructible_v<core::pack_indexing_t<I, Ts...>, Args...>)
     {
         static_assert(I != std::variant_npos);
-        assert(index_ == variant_npos<sizeof...(Ts)>);
+        assert(index_ == rvariant_npos<Ts...>);
         std::construct_at(&storage_, std::in_place_index<I>, std::forward<Args>(args)...);
-        index_ = static_cast<variant_index_t<sizeof...(Ts)>>(I);
+        index_ = static_cast<rvariant_index_t<Ts...>>(I);
     }
 
     template<std::size_t I, class... Args>
@@ -259,7 +295,7 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         static_assert(I != std::variant_npos);
         visit_reset();
         std::construct_at(&storage_, std::in_place_index<I>, std::forward<Args>(args)...);
-        index_ = static_cast<variant_index_t<sizeof...(Ts)>>(I);
+        index_ = static_cast<rvariant_index_t<Ts...>>(I);
     }
 
     template<std::size_t i, std::size_t j, class... Args>
@@ -269,12 +305,12 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         if constexpr (i != std::variant_npos) {
             destroy<i>();
             if constexpr (!std::is_nothrow_constructible_v<core::pack_indexing_t<j, Ts...>, Args...>) {
-                index_ = variant_npos<sizeof...(Ts)>;
+                index_ = rvariant_npos<Ts...>;
             }
         }
         static_assert(j != std::variant_npos);
         std::construct_at(&storage_, std::in_place_index<j>, std::forward<Args>(args)...);
-        index_ = static_cast<variant_index_t<sizeof...(Ts)>>(j);
+        index_ = static_cast<rvariant_index_t<Ts...>>(j);
     }
 
     template<std::size_t I, class... Args>
@@ -285,7 +321,7 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         static_assert(std::is_nothrow_constructible_v<storage_type, std::in_place_index_t<I>, Args...>);
         visit_destroy();
         std::construct_at(&storage_, std::in_place_index<I>, std::forward<Args>(args)...);
-        index_ = static_cast<variant_index_t<sizeof...(Ts)>>(I);
+        index_ = static_cast<rvariant_index_t<Ts...>>(I);
     }
 
 YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
@@ -373,22 +409,27 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
 
                 } else if constexpr (std::is_same_v<T_old_i, T>) { // NOT type-changing
                     if constexpr (
-                        (sizeof(T) <= detail::never_valueless_trivial_size_limit && std::is_trivially_move_assignable_v<T>) ||
+                        (sizeof(T) <= never_valueless_size_limit && std::is_trivially_move_assignable_v<T>) ||
                         core::is_ttp_specialization_of_v<T, recursive_wrapper>
                     ) {
                         T tmp{std::forward<Args>(args)...}; // may throw
                         static_assert(noexcept(t_old_i = std::move(tmp)));
                         t_old_i = std::move(tmp);
                     } else if constexpr (
-                        sizeof(T) <= detail::never_valueless_trivial_size_limit && std::is_trivially_copy_assignable_v<T>
+                        sizeof(T) <= never_valueless_size_limit && std::is_trivially_copy_assignable_v<T>
                     ) { // strange type...
                         T const tmp{std::forward<Args>(args)...}; // may throw
                         static_assert(noexcept(t_old_i = tmp));
                         t_old_i = tmp;
+                    } else if constexpr (nothrow_move_never_valueless && std::is_nothrow_move_constructible_v<T>) {
+                        T tmp(std::forward<Args>(args)...); // may throw
+                        t_old_i.~T_old_i();
+                        static_assert(std::is_nothrow_constructible_v<storage_type, std::in_place_index_t<old_i>, T&&>);
+                        std::construct_at(&this->storage_, std::in_place_index<old_i>, std::move(tmp)); // never throws
                     } else {
                         static_assert(!never_valueless);
                         t_old_i.~T_old_i();
-                        this->index_ = detail::variant_npos<sizeof...(Ts)>;
+                        this->index_ = detail::rvariant_npos<Ts...>;
                         static_assert(!noexcept(std::construct_at(&this->storage(), std::in_place_index<old_i>, std::forward<Args>(args)...)));
                         std::construct_at(&this->storage_, std::in_place_index<old_i>, std::forward<Args>(args)...); // may throw
                         this->index_ = old_i;
@@ -396,7 +437,7 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
 
                 } else { // type-changing
                     if constexpr (
-                        (sizeof(T) <= detail::never_valueless_trivial_size_limit && std::is_trivially_move_constructible_v<T>) ||
+                        (sizeof(T) <= never_valueless_size_limit && std::is_trivially_move_constructible_v<T>) ||
                         core::is_ttp_specialization_of_v<T, recursive_wrapper>
                     ) {
                         T tmp{std::forward<Args>(args)...}; // may throw
@@ -405,17 +446,23 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
                         std::construct_at(&this->storage_, std::in_place_index<I>, std::move(tmp)); // never throws
                         this->index_ = I;
                     } else if constexpr (
-                        sizeof(T) <= detail::never_valueless_trivial_size_limit && std::is_trivially_copy_constructible_v<T>
+                        sizeof(T) <= never_valueless_size_limit && std::is_trivially_copy_constructible_v<T>
                     ) { // strange type...
                         T const tmp{std::forward<Args>(args)...}; // may throw
                         t_old_i.~T_old_i();
                         static_assert(std::is_nothrow_constructible_v<storage_type, std::in_place_index_t<I>, T const&>);
                         std::construct_at(&this->storage_, std::in_place_index<I>, tmp); // never throws
                         this->index_ = I;
+                    } else if constexpr (nothrow_move_never_valueless && std::is_nothrow_move_constructible_v<T>) {
+                        T tmp(std::forward<Args>(args)...); // may throw
+                        t_old_i.~T_old_i();
+                        static_assert(std::is_nothrow_constructible_v<storage_type, std::in_place_index_t<I>, T&&>);
+                        std::construct_at(&this->storage_, std::in_place_index<I>, std::move(tmp)); // never throws
+                        this->index_ = I;
                     } else {
                         static_assert(!never_valueless);
                         t_old_i.~T_old_i();
-                        this->index_ = detail::variant_npos<sizeof...(Ts)>;
+                        this->index_ = detail::rvariant_npos<Ts...>;
                         static_assert(!noexcept(std::construct_at(&this->storage(), std::in_place_index<I>, std::forward<Args>(args)...)));
                         std::construct_at(&this->storage_, std::in_place_index<I>, std::forward<Args>(args)...); // may throw
                         this->index_ = I;
@@ -425,6 +472,33 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_BEGIN
         }
         return detail::unwrap_recursive(detail::raw_get<I>(storage_));
     }
+
+    template<std::size_t I, class F>
+    constexpr variant_alternative_t<I, rvariant<Ts...>>&
+    emplace_with_impl(F&& f)
+        noexcept(is_nothrow_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value) YK_LIFETIMEBOUND
+    {
+        static_assert(I < sizeof...(Ts));
+        using T = core::pack_indexing_t<I, Ts...>;
+
+        if constexpr (is_nothrow_invoke_constructible<T, F>::value) {
+            visit_destroy();
+            std::construct_at(&storage_, std::in_place_index<I>, from_invoke, std::forward<F>(f));
+            index_ = static_cast<rvariant_index_t<Ts...>>(I);
+
+        } else if constexpr (never_valueless) {
+            // Keep the contained value until the callable returns; every
+            // never valueless alternative can be moved in afterwards.
+            T tmp(std::invoke(std::forward<F>(f))); // may throw
+            this->template emplace_impl<I>(std::move(tmp));
+
+        } else {
+            visit_reset();
+            std::construct_at(&storage_, std::in_place_index<I>, from_invoke, std::forward<F>(f)); // may throw
+            index_ = static_cast<rvariant_index_t<Ts...>>(I);
+        }
+        return detail::unwrap_recursive(detail::raw_get<I>(storage_));
+    }
 YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
 
     // -----------------------------------------------------------
@@ -449,7 +523,7 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
     }
 
     storage_type storage_{}; // valueless
-    variant_index_t<sizeof...(Ts)> index_ = variant_npos<sizeof...(Ts)>;
+    rvariant_index_t<Ts...> index_ = rvariant_npos<Ts...>;
 };
 
 
@@ -489,6 +563,12 @@ template<class... Ts>
 }  // detail
 
 
+template<class... Ts>
+struct is_for_overwrite_constructible<rvariant<Ts...>>
+    : std::is_trivially_default_constructible<core::pack_indexing_t<0, Ts...>>
+{};
+
+
 template<class... Ts>
 class rvariant : private detail::rvariant_base_t<Ts...>
 {
@@ -507,6 +587,24 @@ class rvariant : private detail::rvariant_base_t<Ts...>
     using base_type::visit_reset;
     using base_type::reset;
 
+    // `*this` is never valueless but `rvariant<Us...>` (whose `rvariant_policy` may differ)
+    // may be; converting from a valueless `rvariant<Us...>` throws `bad_variant_access`.
+    template<class... Us>
+    static constexpr bool throws_on_valueless_source = base_type::never_valueless && !detail::is_never_valueless_v<Us...>;
+
+    // Used as the initializer of the base, so that the check precedes the
+    // construction; a never valueless `rvariant` cannot be destroyed in the valueless state.
+    template<class... Us>
+    [[nodiscard]] static constexpr detail::valueless_t check_valueless_source(rvariant<Us...> const& w)
+    {
+        if constexpr (throws_on_valueless_source<Us...>) {
+            if (w.valueless_by_exception()) detail::throw_bad_variant_access();
+        } else {
+            (void)w;
+        }
+        return detail::valueless;
+    }
+
 public:
     using base_type::valueless_by_exception;
     using base_type::index;
@@ -517,6 +615,12 @@ public:
         : base_type(std::in_place_index<0>) // value-initialized
     {}
 
+    // Holds the 0th alternative without initializing it (i.e. only the index is written)
+    constexpr explicit rvariant(for_overwrite_t) noexcept
+        requires std::is_trivially_default_constructible_v<core::pack_indexing_t<0, Ts...>>
+        : base_type(for_overwrite)
+    {}
+
     // --------------------------------------
 
     // Generic constructor
@@ -592,7 +696,8 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
             (!std::disjunction_v<std::is_same<rvariant<Us...>, unwrap_recursive_t<Ts>>...>) &&
             std::conjunction_v<std::is_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...>
     constexpr rvariant(rvariant<Us...> const& w)
-        noexcept(std::conjunction_v<std::is_nothrow_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...>)
+        noexcept(std::conjunction_v<std::is_nothrow_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...> && !throws_on_valueless_source<Us...>)
+        : base_type(check_valueless_source(w))
     {
         w.raw_visit([this]<std::size_t j, class Uj>(std::in_place_index_t<j>, [[maybe_unused]] Uj const& uj)
             noexcept(std::conjunction_v<std::is_nothrow_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...>)
@@ -614,7 +719,8 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
             (!std::disjunction_v<std::is_same<rvariant<Us...>, unwrap_recursive_t<Ts>>...>) &&
             std::conjunction_v<std::is_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...>
     constexpr rvariant(rvariant<Us...>&& w)
-        noexcept(std::conjunction_v<std::is_nothrow_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...>)
+        noexcept(std::conjunction_v<std::is_nothrow_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...> && !throws_on_valueless_source<Us...>)
+        : base_type(check_valueless_source(w))
     {
         std::move(w).raw_visit([this]<std::size_t j, class Uj>(std::in_place_index_t<j>, [[maybe_unused]] Uj&& uj)
             noexcept(std::conjunction_v<std::is_nothrow_constructible<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...>)
@@ -639,13 +745,17 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
             (!std::disjunction_v<std::is_same<rvariant<Us...>, unwrap_recursive_t<Ts>>...>) &&
             std::conjunction_v<detail::variant_copy_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...>
     constexpr rvariant& operator=(rvariant<Us...> const& rhs)
-        noexcept(std::conjunction_v<detail::variant_nothrow_copy_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...>)
+        noexcept(std::conjunction_v<detail::variant_nothrow_copy_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...> && !throws_on_valueless_source<Us...>)
     {
         rhs.raw_visit([this]<std::size_t j, class Uj>(std::in_place_index_t<j>, [[maybe_unused]] Uj const& uj)
-            noexcept(std::conjunction_v<detail::variant_nothrow_copy_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...>)
+            noexcept(std::conjunction_v<detail::variant_nothrow_copy_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us const&>...> && !throws_on_valueless_source<Us...>)
         {
             if constexpr (j == std::variant_npos) {
-                this->visit_reset();
+                if constexpr (throws_on_valueless_source<Us...>) {
+                    detail::throw_bad_variant_access(); // leaves `*this` unchanged
+                } else {
+                    this->visit_reset();
+                }
 
             } else {
                 using maybe_wrapped = detail::select_maybe_wrapped<unwrap_recursive_t<Uj>, Ts...>;
@@ -683,13 +793,17 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
             (!std::disjunction_v<std::is_same<rvariant<Us...>, unwrap_recursive_t<Ts>>...>) &&
             std::conjunction_v<detail::variant_move_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...>
     constexpr rvariant& operator=(rvariant<Us...>&& rhs)
-        noexcept(std::conjunction_v<detail::variant_nothrow_move_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...>)
+        noexcept(std::conjunction_v<detail::variant_nothrow_move_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...> && !throws_on_valueless_source<Us...>)
     {
         std::move(rhs).raw_visit([this]<std::size_t j, class Uj>(std::in_place_index_t<j>, [[maybe_unused]] Uj&& uj)
-            noexcept(std::conjunction_v<detail::variant_nothrow_move_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...>)
+            noexcept(std::conjunction_v<detail::variant_nothrow_move_assignable<detail::select_maybe_wrapped_t<unwrap_recursive_t<Us>, Ts...>, Us&&>...> && !throws_on_valueless_source<Us...>)
         {
             if constexpr (j == std::variant_npos) {
-                this->visit_reset();
+                if constexpr (throws_on_valueless_source<Us...>) {
+                    detail::throw_bad_variant_access(); // leaves `*this` unchanged
+                } else {
+                    this->visit_reset();
+                }
 
             } else {
                 using maybe_wrapped = detail::select_maybe_wrapped<unwrap_recursive_t<Uj>, Ts...>;
@@ -758,6 +872,26 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
         : base_type(std::in_place_index<I>, il, std::forward<Args>(args)...)
     {}
 
+    // in_place_type<T>, from_invoke, f
+    template<class T, class F>
+        requires
+            detail::non_wrapped_exactly_once_v<T, unwrapped_types> &&
+            detail::is_invoke_constructible<detail::select_maybe_wrapped_t<T, Ts...>, F>::value
+    constexpr explicit rvariant(std::in_place_type_t<T>, from_invoke_t, F&& f)
+        noexcept(detail::is_nothrow_invoke_constructible<detail::select_maybe_wrapped_t<T, Ts...>, F>::value)
+        : base_type(std::in_place_index<detail::select_maybe_wrapped_index<T, Ts...>>, from_invoke, std::forward<F>(f))
+    {}
+
+    // in_place_index<I>, from_invoke, f
+    template<std::size_t I, class F>
+        requires
+            (I < sizeof...(Ts)) &&
+            detail::is_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value
+    constexpr explicit rvariant(std::in_place_index_t<I>, from_invoke_t, F&& f)
+        noexcept(detail::is_nothrow_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value)
+        : base_type(std::in_place_index<I>, from_invoke, std::forward<F>(f))
+    {}
+
     // -------------------------------------------
 
     template<class T, class... Args>
@@ -801,6 +935,56 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
     }
 
 
+    // Constructs the alternative directly from the result of `f()`
+    template<class T, class F>
+        requires
+            detail::non_wrapped_exactly_once_v<T, unwrapped_types> &&
+            detail::is_invoke_constructible<detail::select_maybe_wrapped_t<T, Ts...>, F>::value
+    constexpr T& emplace_with(F&& f)
+        noexcept(detail::is_nothrow_invoke_constructible<detail::select_maybe_wrapped_t<T, Ts...>, F>::value) YK_LIFETIMEBOUND
+    {
+        return base_type::template emplace_with_impl<detail::select_maybe_wrapped_index<T, Ts...>>(std::forward<F>(f));
+    }
+
+    template<std::size_t I, class F>
+        requires detail::is_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value
+    constexpr variant_alternative_t<I, rvariant>&
+    emplace_with(F&& f)
+        noexcept(detail::is_nothrow_invoke_constructible<core::pack_indexing_t<I, Ts...>, F>::value) YK_LIFETIMEBOUND
+    {
+        static_assert(I < sizeof...(Ts));
+        return base_type::template emplace_with_impl<I>(std::forward<F>(f));
+    }
+
+    // Assigns into the contained value if it holds the alternative; otherwise emplaces.
+    // Unlike `emplace`, this preserves the resources (e.g. capacity) of the contained value.
+    template<class T, class... Args>
+        requires
+            detail::non_wrapped_exactly_once_v<T, unwrapped_types> &&
+            std::is_constructible_v<detail::select_maybe_wrapped_t<T, Ts...>, Args...>
+    constexpr T& assign_or_emplace(Args&&... args)
+        noexcept(detail::variant_nothrow_assign_or_emplace<detail::select_maybe_wrapped_t<T, Ts...>, Args...>::value) YK_LIFETIMEBOUND
+    {
+        return this->template assign_or_emplace<detail::select_maybe_wrapped_index<T, Ts...>>(std::forward<Args>(args)...);
+    }
+
+    template<std::size_t I, class... Args>
+        requires std::is_constructible_v<core::pack_indexing_t<I, Ts...>, Args...>
+    constexpr variant_alternative_t<I, rvariant>&
+    assign_or_emplace(Args&&... args)
+        noexcept(detail::variant_nothrow_assign_or_emplace<core::pack_indexing_t<I, Ts...>, Args...>::value) YK_LIFETIMEBOUND
+    {
+        static_assert(I < sizeof...(Ts));
+        if constexpr (detail::variant_reassignable<core::pack_indexing_t<I, Ts...>, Args...>::value) {
+            if (index_ == I) {
+                auto& alt = detail::raw_get<I>(storage());
+                ((alt = std::forward<Args>(args)), ...); // exactly one argument
+                return detail::unwrap_recursive(alt);
+            }
+        }
+        return base_type::template emplace_impl<I>(std::forward<Args>(args)...);
+    }
+
     constexpr void swap(rvariant& rhs)
         noexcept(std::conjunction_v<std::is_nothrow_move_constructible<Ts>..., std::is_nothrow_swappable<Ts>...>)
     {
@@ -1029,6 +1213,12 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
     template<class R, class V, std::size_t... n>
     friend struct detail::visit_impl;
 
+    template<class R, class Variant>
+    friend struct detail::visit_commutative_impl;
+
+    template<class R, class Variant>
+    friend struct detail::visit_same_impl;
+
     template<class Variant, class Visitor>
     friend constexpr detail::raw_visit_result_t<Visitor, detail::forward_storage_t<Variant>>
     detail::raw_visit(Variant&&, Visitor&&)  // NOLINT(clang-diagnostic-microsoft-exception-spec)
@@ -1042,6 +1232,9 @@ YK_RVARIANT_ALWAYS_THROWING_UNREACHABLE_END
     template<class Compare, class... Ts_>
     friend struct detail::relops_visitor;
 
+    template<class Variant>
+    friend struct detail::index_access;
+
     template<class... Ts_>
         requires std::conjunction_v<core::relop_bool_expr<std::equal_to<>, Ts_>...>
     friend constexpr bool operator==(rvariant<Ts_...> const&, rvariant<Ts_...> const&)
@@ -1256,6 +1449,20 @@ get_if(rvariant<Ts...> const* v) noexcept
 
 namespace detail {
 
+// Lazily computed, so that `std::compare_three_way_result_t` is not
+// required for the alternatives of the other comparisons
+template<class Compare, class... Ts>
+struct relops_result
+{
+    using type = bool;
+};
+
+template<class... Ts>
+struct relops_result<std::compare_three_way, Ts...>
+{
+    using type = std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>;
+};
+
 template<class Compare, class... Ts>
 struct relops_visitor
 {
@@ -1264,11 +1471,7 @@ struct relops_visitor
     using Storage = make_variadic_union_t<Ts...>;
     Storage const& v_storage;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
 
-    using R = std::conditional_t<
-        std::is_same_v<Compare, std::compare_three_way>,
-        std::common_comparison_category_t<std::compare_three_way_result_t<Ts>...>,
-        bool
-    >;
+    using R = typename relops_result<Compare, Ts...>::type;
 
     template<std::size_t i, class T>
     [[nodiscard]] YK_FORCEINLINE constexpr R operator()(std::in_place_index_t<i>, T const& w_alt) const
@@ -1286,6 +1489,67 @@ struct relops_visitor
     }
 };
 
+// for bypassing access control; used by the bulk algorithms over contiguous ranges
+template<class... Ts>
+struct index_access<rvariant<Ts...>>
+{
+    using index_type = rvariant_index_t<Ts...>;
+
+    [[nodiscard]] YK_FORCEINLINE static constexpr index_type raw_index(rvariant<Ts...> const& v) noexcept
+    {
+        return v.index_;
+    }
+
+    // Precondition: the storage of `v` holds an object of the `i`-th alternative
+    YK_FORCEINLINE static constexpr void set_raw_index(rvariant<Ts...>& v, index_type const i) noexcept
+    {
+        v.index_ = i;
+    }
+
+    // Byte offset of the index within `rvariant`
+    [[nodiscard]] static std::size_t offset(rvariant<Ts...> const& v) noexcept
+    {
+        return static_cast<std::size_t>(
+            reinterpret_cast<unsigned char const*>(std::addressof(v.index_)) -
+            reinterpret_cast<unsigned char const*>(std::addressof(v))
+        );
+    }
+};
+
+// Types whose `==` is equivalent to the equality of their object representations.
+// Enumerations are excluded since they may have a user-defined `operator==`.
+template<class T>
+struct is_bitwise_equality_comparable : std::bool_constant<
+    (std::is_integral_v<T> || std::is_pointer_v<T>) &&
+    std::has_unique_object_representations_v<T>
+> {};
+
+template<class... Ts>
+constexpr bool is_bitwise_equality_comparable_all_v = std::conjunction_v<is_bitwise_equality_comparable<Ts>...>;
+
+template<class... Ts>
+constexpr bool is_uniform_size_v = ((sizeof(Ts) == sizeof(core::pack_indexing_t<0, Ts...>)) && ...);
+
+// Compares the index and then the bytes of the active alternative only; the
+// bytes beyond it (and the padding of `rvariant`) are never read.
+template<class... Ts>
+[[nodiscard]] YK_FORCEINLINE bool bitwise_equal(rvariant<Ts...> const& v, rvariant<Ts...> const& w) noexcept
+{
+    static_assert(is_bitwise_equality_comparable_all_v<Ts...>);
+    static_assert(is_never_valueless_v<Ts...>);
+
+    void const* const v_bytes = std::addressof(detail::forward_storage<rvariant<Ts...> const&>(v));
+    void const* const w_bytes = std::addressof(detail::forward_storage<rvariant<Ts...> const&>(w));
+
+    if constexpr (is_uniform_size_v<Ts...>) {
+        // branchless; both storages hold an object of the same size regardless of the index
+        return (v.index() == w.index()) & (std::memcmp(v_bytes, w_bytes, sizeof(core::pack_indexing_t<0, Ts...>)) == 0);
+    } else {
+        static constexpr std::size_t sizes[]{sizeof(Ts)...};
+        return v.index() == w.index() && std::memcmp(v_bytes, w_bytes, sizes[v.index()]) == 0;
+    }
+}
+
 } // detail
 
 
@@ -1294,6 +1558,11 @@ template<class... Ts>
 [[nodiscard]] constexpr bool operator==(rvariant<Ts...> const& v, rvariant<Ts...> const& w)
     noexcept(std::conjunction_v<std::is_nothrow_invocable_r<bool, std::equal_to<>, Ts const&, Ts const&>...>)
 {
+    if constexpr (detail::is_bitwise_equality_comparable_all_v<Ts...>) {
+        if !consteval {
+            return detail::bitwise_equal(v, w);
+        }
+    }
     auto const vi = detail::valueless_bias<rvariant<Ts...>>(v.index_);
     auto const wi = detail::valueless_bias<rvariant<Ts...>>(w.index_);
     return vi == wi && detail::raw_visit_i(wi, w, detail::relops_visitor<std::equal_to<>, Ts...>{v.storage_});
@@ -1304,6 +1573,11 @@ template<class... Ts>
 [[nodiscard]] constexpr bool operator!=(rvariant<Ts...> const& v, rvariant<Ts...> const& w)
     noexcept(std::conjunction_v<std::is_nothrow_invocable_r<bool, std::not_equal_to<>, Ts const&, Ts const&>...>)
 {
+    if constexpr (detail::is_bitwise_equality_comparable_all_v<Ts...>) {
+        if !consteval {
+            return !detail::bitwise_equal(v, w);
+        }
+    }
     auto const vi = detail::valueless_bias<rvariant<Ts...>>(v.index_);
     auto const wi = detail::valueless_bias<rvariant<Ts...>>(w.index_);
     return vi != wi || detail::raw_visit_i(wi, w, detail::relops_visitor<std::not_equal_to<>, Ts...>{v.storage_});
@@ -1399,6 +1673,98 @@ operator<=>(rvariant<Ts...> const& v, rvariant<Ts...> const& w)
         detail::raw_visit_i(wi, w, detail::relops_visitor<std::compare_three_way, Ts...>{v.storage_});
 }
 
+namespace detail {
+
+// Mixes the hash of the alternative with its index; see `std::hash<rvariant>` below.
+// Any hasher that must agree with `std::hash<rvariant>` shall use this.
+template<std::size_t I>
+[[nodiscard]] constexpr std::size_t variant_hash_mix(std::size_t const alt_hash) noexcept
+{
+    constexpr std::size_t index_hash = ::yk::FNV_hash<>::hash(I);
+    return index_hash + alt_hash;
+}
+
+// Out-of-line body of `std::hash<rvariant>`; see <yk/rvariant/explicit_instantiation.hpp>
+template<class... Ts>
+struct rvariant_ops
+{
+    // Not `constexpr`; defined out of class so that it is not inline, which lets an
+    // explicit instantiation declaration suppress its instantiation in other translation units.
+    [[nodiscard]] static std::size_t hash(rvariant<Ts...> const& v)
+        noexcept(std::conjunction_v<core::is_nothrow_hashable<std::remove_const_t<Ts>>...>)
+        requires std::conjunction_v<core::is_hash_enabled<std::remove_const_t<Ts>>...>;
+};
+
+template<class... Ts>
+std::size_t rvariant_ops<Ts...>::hash(rvariant<Ts...> const& v)
+    noexcept(std::conjunction_v<core::is_nothrow_hashable<std::remove_const_t<Ts>>...>)
+    requires std::conjunction_v<core::is_hash_enabled<std::remove_const_t<Ts>>...>
+{
+    return detail::raw_visit(v, []<std::size_t i, class T>(std::in_place_index_t<i>, T const& t) static
+        noexcept(std::disjunction_v<
+            std::bool_constant<i == std::variant_npos>,
+            core::is_nothrow_hashable<T>
+        >)
+    {
+        if constexpr (i == std::variant_npos) {
+            // Arbitrary value. Might be better to not use common values like
+            // `0` or `-1`, because some hash implementations yield the re-interpreted
+            // integral representation for fundamental types.
+            (void)t;
+            return 0xbaddeadbeefuz;
+
+        } else {
+            // Assume x64 for the description below. This assumption is solely for
+            // demonstration, and the issue described below applies to any architecture.
+            //
+            // Let `Int` denote a strong typedef of `int` such that:
+            //   -- The specialization `std::hash<Int>` is _enabled_ ([unord.hash]), and
+            //   -- such specialization yields the same value as the underlying type.
+            //
+            // Statement 1.
+            // For any standard library implementation,
+            //   hash{}(variant<int, Int>{std::in_place_type<int>, 0}) ==
+            //   hash{}(variant<int, Int>{std::in_place_type<Int>, 0})
+            // yields false-positive `true` if `v.index()` is not hash-mixed.
+            //
+            // Statement 2.
+            // Additionally, for any standard library implementation where
+            //   hash{}(int(0)) == hash(unsigned(0)) // true in GCC/Clang/MSVC
+            // is true, then:
+            //   hash{}(variant<int, unsigned>{std::in_place_type<int>, 0}) ==
+            //   hash{}(variant<int, unsigned>{std::in_place_type<unsigned>, 0})
+            // yields false-positive `true` if `v.index()` is not hash-mixed.
+            //
+            // Statement 3.
+            // Furthermore, for any standard library implementation where
+            // the hash function does not consider the type's actual bit width, i.e.:
+            //   hash{}(int(0)) == hash{}(long long(0)) // true in GCC/Clang, false in MSVC
+            // the following expression:
+            //   hash{}(variant<int, long long>{std::in_place_type<int>, 0}) ==
+            //   hash{}(variant<int, long long>{std::in_place_type<long long>, 0})
+            // yields false-positive `true` if `v.index()` is not hash-mixed.
+            //
+            // For the statements 1 and 2, one may embrace the status quo and just live
+            // with hash collisions. However, for the statement 3, it is actually
+            // HARMFUL because an end-user will face observable performance issues
+            // just by switching their compiler from MSVC to GCC/Clang.
+            //
+            // Demo: https://godbolt.org/z/aKhs4vbco
+            //
+            // All above issues can be eliminated by simply returning
+            //   `HC(v.index(), GET<v.index()>(v))`
+            // where `HC` is an arbitrary hash mixer function.
+
+            // We assume `hash_combine` is unnecessary here, since the collision
+            // is very unlikely to occur as long as the `index_hash` is NOT
+            // evaluated as the re-interpreted bit representation.
+            return variant_hash_mix<i>(std::hash<T>{}(t));
+        }
+    });
+}
+
+} // detail
+
 }  // yk
 
 
@@ -1412,68 +1778,7 @@ struct hash<::yk::rvariant<Ts...>>  // NOLINT(cert-dcl58-cpp)
     [[nodiscard]] static /* constexpr */ std::size_t operator()(::yk::rvariant<Ts...> const& v)
         noexcept(std::conjunction_v<::yk::core::is_nothrow_hashable<std::remove_const_t<Ts>>...>)
     {
-        return ::yk::detail::raw_visit(v, []<std::size_t i, class T>(std::in_place_index_t<i>, T const& t) static
-            noexcept(std::disjunction_v<
-                std::bool_constant<i == std::variant_npos>,
-                ::yk::core::is_nothrow_hashable<T>
-            >)
-        {
-            if constexpr (i == std::variant_npos) {
-                // Arbitrary value. Might be better to not use common values like
-                // `0` or `-1`, because some hash implementations yield the re-interpreted
-                // integral representation for fundamental types.
-                (void)t;
-                return 0xbaddeadbeefuz;
-
-            } else {
-                // Assume x64 for the description below. This assumption is solely for
-                // demonstration, and the issue described below applies to any architecture.
-                //
-                // Let `Int` denote a strong typedef of `int` such that:
-                //   -- The specialization `std::hash<Int>` is _enabled_ ([unord.hash]), and
-                //   -- such specialization yields the same value as the underlying type.
-                //
-                // Statement 1.
-                // For any standard library implementation,
-                //   hash{}(variant<int, Int>{std::in_place_type<int>, 0}) ==
-                //   hash{}(variant<int, Int>{std::in_place_type<Int>, 0})
-                // yields false-positive `true` if `v.index()` is not hash-mixed.
-                //
-                // Statement 2.
-                // Additionally, for any standard library implementation where
-                //   hash{}(int(0)) == hash(unsigned(0)) // true in GCC/Clang/MSVC
-                // is true, then:
-                //   hash{}(variant<int, unsigned>{std::in_place_type<int>, 0}) ==
-                //   hash{}(variant<int, unsigned>{std::in_place_type<unsigned>, 0})
-                // yields false-positive `true` if `v.index()` is not hash-mixed.
-                //
-                // Statement 3.
-                // Furthermore, for any standard library implementation where
-                // the hash function does not consider the type's actual bit width, i.e.:
-                //   hash{}(int(0)) == hash{}(long long(0)) // true in GCC/Clang, false in MSVC
-                // the following expression:
-                //   hash{}(variant<int, long long>{std::in_place_type<int>, 0}) ==
-                //   hash{}(variant<int, long long>{std::in_place_type<long long>, 0})
-                // yields false-positive `true` if `v.index()` is not hash-mixed.
-                //
-                // For the statements 1 and 2, one may embrace the status quo and just live
-                // with hash collisions. However, for the statement 3, it is actually
-                // HARMFUL because an end-user will face observable performance issues
-                // just by switching their compiler from MSVC to GCC/Clang.
-                //
-                // Demo: https://godbolt.org/z/aKhs4vbco
-                //
-                // All above issues can be eliminated by simply returning
-                //   `HC(v.index(), GET<v.index()>(v))`
-                // where `HC` is an arbitrary hash mixer function.
-
-                // We assume `hash_combine` is unnecessary here, since the collision
-                // is very unlikely to occur as long as the `index_hash` is NOT
-                // evaluated as the re-interpreted bit representation.
-                constexpr std::size_t index_hash = ::yk::FNV_hash<>::hash(i);
-                return index_hash + std::hash<T>{}(t);
-            }
-        });
+        return ::yk::detail::rvariant_ops<Ts...>::hash(v);
     }
 };
 
@@ -11,6 +11,10 @@
 #include <yk/format_traits.hpp>
 
 #include <format>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <utility>
 // ReSharper disable once CppUnusedIncludeDirective
 #include <ostream>
 
@@ -37,14 +41,19 @@ namespace detail {
     }
 }
 
-} // detail
-
+// Out-of-line body of `operator<<`; see `rvariant_ops` in <yk/rvariant/rvariant.hpp>.
+// `write` is defined out of class so that it is not inline, which lets an
+// explicit instantiation declaration suppress its instantiation in other translation units.
+template<class... Ts>
+struct rvariant_io_ops
+{
+    static std::ostream& write(std::ostream& os, rvariant<Ts...> const& v)
+        requires std::conjunction_v<core::ADL_ostreamable<unwrap_recursive_t<Ts>>...>;
+};
 
-// Behaves mostly like *formatted output function* (https://eel.is/c++draft/ostream.formatted.reqmts),
-// except that `std::bad_variant_access` will always be propagated.
 template<class... Ts>
+std::ostream& rvariant_io_ops<Ts...>::write(std::ostream& os, rvariant<Ts...> const& v)
     requires std::conjunction_v<core::ADL_ostreamable<unwrap_recursive_t<Ts>>...>
-std::ostream& operator<<(std::ostream& os, rvariant<Ts...> const& v)
 {
     std::ostream::sentry sentry(os);
     if (!sentry) {
@@ -77,6 +86,103 @@ std::ostream& operator<<(std::ostream& os, rvariant<Ts...> const& v)
     return os;
 }
 
+} // detail
+
+// Behaves mostly like *formatted output function* (https://eel.is/c++draft/ostream.formatted.reqmts),
+// except that `std::bad_variant_access` will always be propagated.
+template<class... Ts>
+    requires std::conjunction_v<core::ADL_ostreamable<unwrap_recursive_t<Ts>>...>
+std::ostream& operator<<(std::ostream& os, rvariant<Ts...> const& v)
+{
+    return detail::rvariant_io_ops<Ts...>::write(os, v);
+}
+
+namespace detail {
+
+// Suppresses the per-element flush of the tied stream and `unitbuf`
+// during bulk output; the outer sentry takes care of them once.
+class ostream_batch_guard
+{
+public:
+    explicit ostream_batch_guard(std::ostream& os)
+        : os_(os)
+        , tie_(os.tie(nullptr))
+        , unitbuf_((os.flags() & std::ios_base::unitbuf) != 0)
+    {
+        os_.unsetf(std::ios_base::unitbuf);
+    }
+
+    ostream_batch_guard(ostream_batch_guard const&) = delete;
+    ostream_batch_guard& operator=(ostream_batch_guard const&) = delete;
+
+    ~ostream_batch_guard()
+    {
+        if (unitbuf_) os_.setf(std::ios_base::unitbuf);
+        os_.tie(tie_);
+    }
+
+private:
+    std::ostream& os_;
+    std::ostream* tie_;
+    bool unitbuf_;
+};
+
+} // detail
+
+// Writes all elements of `r` separated by `sep`, under a single sentry.
+// Has the same error semantics as `operator<<` for a single rvariant;
+// output stops at the first element which fails.
+template<std::ranges::input_range R, class Sep = std::string_view>
+    requires
+        core::is_ttp_specialization_of_v<std::remove_cvref_t<std::ranges::range_reference_t<R>>, rvariant> &&
+        core::ADL_ostreamable_v<std::remove_cvref_t<std::ranges::range_reference_t<R>>> &&
+        requires(std::ostream& os, Sep const& sep) {
+            { os << sep } -> std::same_as<std::ostream&>;
+        }
+std::ostream& write_all(std::ostream& os, R&& r, Sep const& sep = Sep{})
+{
+    using V = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+    std::ostream::sentry sentry(os);
+    if (!sentry) {
+        os.setstate(std::ios_base::badbit);
+        return os;
+    }
+
+    try {
+        detail::ostream_batch_guard const guard(os);
+
+        bool first = true;
+        for (auto&& elem : r) {
+            V const& v = elem;
+            if (!first) {
+                os << sep;
+            }
+            first = false;
+
+            if (v.valueless_by_exception()) [[unlikely]] {
+                detail::throw_bad_variant_access();
+            }
+            detail::raw_visit(v, [&os]<std::size_t i>(std::in_place_index_t<i>, [[maybe_unused]] auto const& o) {
+                if constexpr (i == std::variant_npos) {
+                    std::unreachable();
+                } else {
+                    os << detail::unwrap_recursive(o);
+                }
+            });
+            if (!os) break;
+        }
+
+    } catch (std::bad_variant_access const&) {
+        throw; // always throw, regardless of `os.exceptions()`
+
+    } catch (...) {
+        bool const need_rethrow = detail::set_iostate_check_rethrow(os, std::ios_base::badbit);
+        if (need_rethrow) throw;
+    }
+    return os;
+}
+
 // ----------------------------------------------------
 // std::formatter support
 
@@ -188,37 +294,86 @@ struct variant_alts_formattable<charT, rvariant<Ts...>>
 
 namespace std {
 
+// The format spec is parsed once per alternative in `parse()`, and `format()`
+// writes through the pre-parsed formatter of the active alternative. The same
+// spec is applied to whichever alternative is active, so it must be valid for
+// all of them (e.g. `{:>8}`). Nested replacement fields are not supported.
 template<class... Ts, class charT>
     requires (std::formattable<::yk::unwrap_recursive_t<Ts>, charT> && ...)
 struct formatter<::yk::rvariant<Ts...>, charT>  // NOLINT(cert-dcl58-cpp)
 {
-    static constexpr typename std::basic_format_parse_context<charT>::const_iterator
-    parse(std::basic_format_parse_context<charT>& ctx)
+private:
+    using parse_context_type = std::basic_format_parse_context<charT>;
+    using spec_view_type = std::basic_string_view<charT>;
+
+    // `recursive_wrapper<T>` may refer to an incomplete `T` at this point, so
+    // the formatter for such alternative is instantiated lazily in `format()`.
+    struct deferred_formatter {};
+
+    template<class T>
+    using alt_formatter_t = std::conditional_t<
+        ::yk::core::is_ttp_specialization_of_v<T, ::yk::recursive_wrapper>,
+        deferred_formatter,
+        std::formatter<T, charT>
+    >;
+
+    template<class Formatter>
+    static constexpr std::size_t parse_spec(Formatter& f, spec_view_type const spec)
     {
-        if (ctx.begin() == ctx.end()) return ctx.begin();
-        if (*ctx.begin() == ::yk::format_traits<charT>::brace_close) return ctx.begin();
-        throw std::format_error(
-            "rvariant itself only accepts empty format spec `{}`; use "
-            "`format_by` or manually dispatch alternatives in `visit` "
-            "if you need more controls."
-        );
+        parse_context_type sub_ctx(spec);
+        return static_cast<std::size_t>(f.parse(sub_ctx) - sub_ctx.begin());
+    }
+
+    template<std::size_t I>
+    constexpr std::size_t parse_alternative(spec_view_type const spec)
+    {
+        using T = ::yk::core::pack_indexing_t<I, Ts...>;
+        if constexpr (::yk::core::is_ttp_specialization_of_v<T, ::yk::recursive_wrapper>) {
+            std::formatter<::yk::unwrap_recursive_t<T>, charT> f; // validate only
+            return parse_spec(f, spec);
+        } else {
+            return parse_spec(std::get<I>(formatters_), spec);
+        }
+    }
+
+    std::tuple<alt_formatter_t<Ts>...> formatters_{};
+    spec_view_type spec_{};
+
+public:
+    constexpr typename parse_context_type::const_iterator
+    parse(parse_context_type& ctx)
+    {
+        spec_view_type const rest(ctx.begin(), ctx.end());
+        std::size_t const spec_size = [&, this]<std::size_t... Is>(std::index_sequence<Is...>) {
+            std::size_t const sizes[]{this->template parse_alternative<Is>(rest)...};
+            for (std::size_t const size : sizes) {
+                if (size != sizes[0]) {
+                    throw std::format_error("format spec must be consumed identically by all alternatives of rvariant");
+                }
+            }
+            return sizes[0];
+        }(std::index_sequence_for<Ts...>{});
+
+        spec_ = rest.substr(0, spec_size);
+        return ctx.begin() + static_cast<std::ptrdiff_t>(spec_size);
     }
 
     template<class OutIt>
-    static OutIt format(::yk::rvariant<Ts...> const& v, std::basic_format_context<OutIt, charT>& ctx)
+    OutIt format(::yk::rvariant<Ts...> const& v, std::basic_format_context<OutIt, charT>& ctx) const
     {
         return ::yk::detail::raw_visit(
             v,
-            [&]<std::size_t i, class VT>(std::in_place_index_t<i>, VT const& alt) -> OutIt {
+            [&, this]<std::size_t i, class VT>(std::in_place_index_t<i>, VT const& alt) -> OutIt {
                 if constexpr (i == std::variant_npos) {
                     (void)alt;
                     ::yk::detail::throw_bad_variant_access();
+                } else if constexpr (::yk::core::is_ttp_specialization_of_v<VT, ::yk::recursive_wrapper>) {
+                    std::formatter<::yk::unwrap_recursive_t<VT>, charT> f;
+                    parse_context_type sub_ctx(spec_);
+                    f.parse(sub_ctx);
+                    return f.format(::yk::detail::unwrap_recursive(alt), ctx);
                 } else {
-                    return std::format_to(
-                        ctx.out(),
-                        ::yk::format_traits<charT>::template brace_full<::yk::unwrap_recursive_t<VT> const&>,
-                        ::yk::detail::unwrap_recursive(alt)
-                    );
+                    return std::get<i>(formatters_).format(alt, ctx);
                 }
             }
         );
@@ -0,0 +1,216 @@
+﻿#ifndef YK_RVARIANT_RVARIANT_PARSE_HPP
+#define YK_RVARIANT_RVARIANT_PARSE_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <yk/rvariant/rvariant.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <cstddef>
+
+namespace yk {
+
+// Customization point for `parse_into`.
+//
+// `text_parser<T>::parse(str, emplace)` shall parse the *entire* `str` as `T`,
+// and then call `emplace(args...)` exactly once with the arguments for
+// constructing `T`. If `str` is not a valid representation of `T`, it shall
+// return `false` without calling `emplace`.
+template<class T>
+struct text_parser;
+
+template<>
+struct text_parser<std::monostate>
+{
+    template<class Emplace>
+    static constexpr bool parse(std::string_view const str, Emplace&& emplace)
+    {
+        if (!str.empty()) return false;
+        std::forward<Emplace>(emplace)();
+        return true;
+    }
+};
+
+template<>
+struct text_parser<bool>
+{
+    template<class Emplace>
+    static constexpr bool parse(std::string_view const str, Emplace&& emplace)
+    {
+        if (str == "true") {
+            std::forward<Emplace>(emplace)(true);
+            return true;
+        }
+        if (str == "false") {
+            std::forward<Emplace>(emplace)(false);
+            return true;
+        }
+        return false;
+    }
+};
+
+template<class T>
+    requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
+struct text_parser<T>
+{
+    template<class Emplace>
+    static constexpr bool parse(std::string_view const str, Emplace&& emplace)
+    {
+        char const* const last = str.data() + str.size();
+        T value{};
+        auto const [ptr, ec] = std::from_chars(str.data(), last, value);
+        if (ec != std::errc{} || ptr != last) return false;
+        std::forward<Emplace>(emplace)(value);
+        return true;
+    }
+};
+
+template<class T>
+    requires std::is_floating_point_v<T>
+struct text_parser<T>
+{
+    template<class Emplace>
+    static bool parse(std::string_view const str, Emplace&& emplace)
+    {
+        char const* const last = str.data() + str.size();
+        T value{};
+        auto const [ptr, ec] = std::from_chars(str.data(), last, value);
+        if (ec != std::errc{} || ptr != last) return false;
+        std::forward<Emplace>(emplace)(value);
+        return true;
+    }
+};
+
+template<>
+struct text_parser<std::string_view>
+{
+    template<class Emplace>
+    static constexpr bool parse(std::string_view const str, Emplace&& emplace)
+    {
+        std::forward<Emplace>(emplace)(str);
+        return true;
+    }
+};
+
+template<class Allocator>
+struct text_parser<std::basic_string<char, std::char_traits<char>, Allocator>>
+{
+    template<class Emplace>
+    static constexpr bool parse(std::string_view const str, Emplace&& emplace)
+    {
+        std::forward<Emplace>(emplace)(str);
+        return true;
+    }
+};
+
+
+// The order in which `parse_into` tries the alternatives.
+// The first alternative which accepts the input is chosen.
+template<std::size_t... Is>
+struct parse_order {};
+
+namespace detail {
+
+template<class Variant, class Seq = std::make_index_sequence<variant_size_v<Variant>>>
+struct default_parse_order;
+
+template<class Variant, std::size_t... Is>
+struct default_parse_order<Variant, std::index_sequence<Is...>>
+{
+    using type = parse_order<Is...>;
+};
+
+template<class Variant, std::size_t I, class EmplaceAt>
+[[nodiscard]] constexpr bool parse_alternative(std::string_view const str, EmplaceAt& emplace_at)
+{
+    static_assert(I < variant_size_v<Variant>, "index in `parse_order` is out of range");
+    using RawT = raw_alternative_t<I, Variant>;
+    using T = unwrap_recursive_t<RawT>;
+    return text_parser<T>::parse(str, [&emplace_at]<class... Args>(Args&&... args) {
+        if constexpr (core::is_ttp_specialization_of_v<RawT, recursive_wrapper>) {
+            emplace_at(std::in_place_index<I>, std::in_place, std::forward<Args>(args)...);
+        } else {
+            emplace_at(std::in_place_index<I>, std::forward<Args>(args)...);
+        }
+    });
+}
+
+template<class Variant, std::size_t... Is, class EmplaceAt>
+[[nodiscard]] constexpr bool parse_alternatives(std::string_view const str, parse_order<Is...>, EmplaceAt& emplace_at)
+{
+    return (detail::parse_alternative<Variant, Is>(str, emplace_at) || ...);
+}
+
+} // detail
+
+template<class Variant>
+using default_parse_order_t = typename detail::default_parse_order<Variant>::type;
+
+
+// Constructs the first alternative (in `Order`) which accepts `str`
+// directly in `v`, via `v.emplace<I>(...)`. Returns `false` and leaves
+// `v` unchanged if no alternative accepts `str`.
+template<class Variant, class Order = default_parse_order_t<Variant>>
+    requires core::is_ttp_specialization_of_v<Variant, rvariant>
+constexpr bool parse_into(Variant& v, std::string_view const str, Order const order = Order{})
+{
+    auto emplace_at = [&v]<std::size_t I, class... Args>(std::in_place_index_t<I>, Args&&... args) {
+        v.template emplace<I>(std::forward<Args>(args)...);
+    };
+    return detail::parse_alternatives<Variant>(str, order, emplace_at);
+}
+
+template<class Variant, class Order = default_parse_order_t<Variant>>
+    requires core::is_ttp_specialization_of_v<Variant, rvariant>
+[[nodiscard]] constexpr std::optional<Variant> parse_into(std::string_view const str, Order const order = Order{})
+{
+    std::optional<Variant> result;
+    auto emplace_at = [&result]<std::size_t I, class... Args>(std::in_place_index_t<I> tag, Args&&... args) {
+        result.emplace(tag, std::forward<Args>(args)...);
+    };
+    (void)detail::parse_alternatives<Variant>(str, order, emplace_at);
+    return result;
+}
+
+// Batch version of `parse_into`, for arrays of fields.
+// Parses `fields[i]` into `out[i]` and returns the number of fields
+// successfully parsed; stops at the first field which is not accepted.
+template<
+    std::ranges::input_range Fields,
+    std::ranges::random_access_range Out,
+    class Order = default_parse_order_t<std::ranges::range_value_t<Out>>
+>
+    requires
+        std::convertible_to<std::ranges::range_reference_t<Fields>, std::string_view> &&
+        core::is_ttp_specialization_of_v<std::ranges::range_value_t<Out>, rvariant>
+constexpr std::size_t parse_all(Fields&& fields, Out&& out, Order const order = Order{})
+{
+    auto out_it = std::ranges::begin(out);
+    auto const out_last = std::ranges::end(out);
+    std::size_t n = 0;
+
+    for (std::string_view const field : fields) {
+        if (out_it == out_last) break;
+        if (!yk::parse_into(*out_it, field, order)) break;
+        ++out_it;
+        ++n;
+    }
+    return n;
+}
+
+} // yk
+
+#endif
@@ -0,0 +1,167 @@
+﻿#ifndef YK_RVARIANT_SHARED_RVARIANT_HPP
+#define YK_RVARIANT_SHARED_RVARIANT_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Seqlock-protected rvariant for single-writer, multi-reader publication
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/core/type_traits.hpp>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <cstddef>
+#include <cstring>
+
+namespace yk {
+
+namespace detail {
+
+template<class Variant>
+struct is_seqlock_publishable : std::false_type {};
+
+template<class... Ts>
+struct is_seqlock_publishable<rvariant<Ts...>>
+    : std::bool_constant<std::is_trivially_copyable_v<rvariant<Ts...>> && is_never_valueless_v<Ts...>>
+{};
+
+inline constexpr std::size_t seqlock_cache_line_size = 64;
+
+} // detail
+
+template<class Variant>
+inline constexpr bool is_seqlock_publishable_v = detail::is_seqlock_publishable<Variant>::value;
+
+// The object representation is held in relaxed atomic words so that a
+// reader racing with the writer never performs a data race; a torn copy
+// is detected by the sequence number and discarded.
+template<class Variant>
+class shared_rvariant
+{
+    static_assert(is_seqlock_publishable_v<Variant>, "the alternatives shall be trivially copyable and never valueless");
+
+    using word_type = std::size_t;
+    static constexpr std::size_t word_count = (sizeof(Variant) + sizeof(word_type) - 1) / sizeof(word_type);
+
+    struct snapshot
+    {
+        alignas(Variant) alignas(word_type) unsigned char bytes[word_count * sizeof(word_type)];
+
+        [[nodiscard]] Variant const& get() const noexcept
+        {
+            return *std::launder(reinterpret_cast<Variant const*>(bytes));
+        }
+    };
+
+public:
+    shared_rvariant() noexcept(std::is_nothrow_default_constructible_v<Variant>)
+        requires std::is_default_constructible_v<Variant>
+        : shared_rvariant(Variant{})
+    {}
+
+    explicit shared_rvariant(Variant const& v) noexcept
+    {
+        this->write_words(v);
+    }
+
+    template<std::size_t I, class... Args>
+        requires std::is_constructible_v<Variant, std::in_place_index_t<I>, Args...>
+    explicit shared_rvariant(std::in_place_index_t<I>, Args&&... args)
+        : shared_rvariant(Variant(std::in_place_index<I>, std::forward<Args>(args)...))
+    {}
+
+    shared_rvariant(shared_rvariant const&) = delete;
+    shared_rvariant& operator=(shared_rvariant const&) = delete;
+
+    // Writer side; shall not be called concurrently with itself.
+    void store(Variant const& v) noexcept
+    {
+        std::size_t const seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        this->write_words(v);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    template<std::size_t I, class... Args>
+        requires std::is_constructible_v<Variant, std::in_place_index_t<I>, Args...>
+    void emplace(Args&&... args)
+    {
+        // The new value is constructed before the write section begins, so
+        // readers are never held up by (or exposed to) its construction.
+        this->store(Variant(std::in_place_index<I>, std::forward<Args>(args)...));
+    }
+
+    template<class T, class... Args>
+        requires std::is_constructible_v<Variant, std::in_place_type_t<T>, Args...>
+    void emplace(Args&&... args)
+    {
+        this->store(Variant(std::in_place_type<T>, std::forward<Args>(args)...));
+    }
+
+    // Reader side; may be called concurrently with anything.
+    [[nodiscard]] Variant load() const noexcept
+    {
+        snapshot s;
+        this->read_snapshot(s);
+        return s.get();
+    }
+
+    // Calls `vis` on a consistent copy of the current value. The copy is
+    // retried until it is not torn; `vis` itself is called exactly once.
+    template<class Visitor>
+    decltype(auto) visit(Visitor&& vis) const
+    {
+        snapshot s;
+        this->read_snapshot(s);
+        return yk::visit(std::forward<Visitor>(vis), s.get());
+    }
+
+    // Number of completed writes
+    [[nodiscard]] std::size_t version() const noexcept
+    {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    void write_words(Variant const& v) noexcept
+    {
+        word_type tmp[word_count]{};
+        std::memcpy(tmp, std::addressof(v), sizeof(Variant));
+        for (std::size_t k = 0; k < word_count; ++k) {
+            words_[k].store(tmp[k], std::memory_order_relaxed);
+        }
+    }
+
+    void read_snapshot(snapshot& s) const noexcept
+    {
+        for (;;) {
+            std::size_t const seq0 = seq_.load(std::memory_order_acquire);
+            if (seq0 & 1) continue; // write in progress
+
+            word_type tmp[word_count];
+            for (std::size_t k = 0; k < word_count; ++k) {
+                tmp[k] = words_[k].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == seq0) {
+                std::memcpy(s.bytes, tmp, sizeof(tmp));
+                return;
+            }
+        }
+    }
+
+    alignas(detail::seqlock_cache_line_size) std::atomic<std::size_t> seq_{0};
+    std::atomic<word_type> words_[word_count];
+};
+
+} // yk
+
+#endif
@@ -0,0 +1,192 @@
+﻿#ifndef YK_RVARIANT_TREE_BUILDER_HPP
+#define YK_RVARIANT_TREE_BUILDER_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/rvariant/recursive_wrapper.hpp>
+#include <yk/core/type_traits.hpp>
+
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+namespace yk {
+
+namespace detail {
+
+template<class Container>
+concept tree_map_like = requires {
+    typename Container::key_type;
+    typename Container::mapped_type;
+};
+
+template<class Container>
+concept tree_pair_sequence =
+    (!tree_map_like<Container>) &&
+    core::is_ttp_specialization_of_v<typename Container::value_type, std::pair>;
+
+template<class Value, class Container>
+struct tree_container_index;
+
+template<class... Ts, class Container>
+struct tree_container_index<rvariant<Ts...>, Container>
+    : std::integral_constant<std::size_t, select_maybe_wrapped_index<Container, Ts...>>
+{};
+
+} // detail
+
+
+// Push-style (SAX-style) builder for recursive rvariant trees.
+//
+// Each node is constructed in place, directly in its final slot in the
+// parent container; no subtree is ever moved. Open containers are kept
+// on an explicit stack, hence the auxiliary memory is O(depth).
+//
+// `Containers...` are the container types which may appear as the
+// alternatives of `Value` (either as is, or wrapped in `recursive_wrapper`).
+// A container is either a sequence of `Value` (`emplace_back`), a sequence
+// of `std::pair<Key, Value>`, or a map-like container with `try_emplace`.
+template<class Value, class... Containers>
+class tree_builder
+{
+    static_assert(core::is_ttp_specialization_of_v<Value, rvariant>);
+    static_assert(sizeof...(Containers) > 0);
+
+    using frame_type = rvariant<Containers*...>;
+
+public:
+    using value_type = Value;
+
+    tree_builder() = default;
+
+    // `mr` is used for the stack, and for the allocation of
+    // `recursive_wrapper` whose allocator is constructible from `mr`
+    // (i.e. `yk::pmr::recursive_wrapper`).
+    explicit tree_builder(std::pmr::memory_resource* mr) noexcept
+        : mr_(mr)
+        , stack_(mr)
+    {}
+
+    // Precondition for all events: `!complete()`.
+
+    // Constructs `Value(std::forward<Args>(args)...)` as a leaf.
+    template<class... Args>
+        requires std::is_constructible_v<Value, Args...>
+    void value(Args&&... args)
+    {
+        (void)this->emplace_node(std::forward<Args>(args)...);
+    }
+
+    // Constructs an empty `Container` and makes it the current container.
+    template<class Container>
+    void begin()
+    {
+        static_assert(core::is_in_v<Container, Containers...>, "`Container` must be one of `Containers...`");
+        constexpr std::size_t I = detail::tree_container_index<Value, Container>::value;
+        using RawT = detail::raw_alternative_t<I, Value>;
+
+        Value* node;
+        if constexpr (core::is_ttp_specialization_of_v<RawT, recursive_wrapper>) {
+            using allocator_type = typename RawT::allocator_type;
+            if constexpr (std::is_constructible_v<allocator_type, std::pmr::memory_resource*>) {
+                node = &this->emplace_node(std::in_place_index<I>, std::allocator_arg, allocator_type(mr_), std::in_place);
+            } else {
+                node = &this->emplace_node(std::in_place_index<I>, std::in_place);
+            }
+        } else {
+            node = &this->emplace_node(std::in_place_index<I>);
+        }
+
+        constexpr std::size_t frame_index = core::find_index_v<Container, core::type_list<Containers...>>;
+        stack_.emplace_back(std::in_place_index<frame_index>, std::addressof(yk::get<I>(*node)));
+    }
+
+    // Closes the current container.
+    // Precondition: `depth() > 0`.
+    void end() noexcept
+    {
+        assert(!stack_.empty());
+        stack_.pop_back();
+    }
+
+    // Sets the key for the next element of a map-like container
+    // (or a sequence of pairs). `k` must remain valid until the next event.
+    void key(std::string_view const k) noexcept
+    {
+        key_ = k;
+    }
+
+    [[nodiscard]] std::size_t depth() const noexcept { return stack_.size(); }
+    [[nodiscard]] bool complete() const noexcept { return root_.has_value() && stack_.empty(); }
+
+    // Precondition: `complete()`
+    [[nodiscard]] Value& root() noexcept
+    {
+        assert(this->complete());
+        return *root_;
+    }
+
+    // Precondition: `complete()`
+    [[nodiscard]] Value release() noexcept(std::is_nothrow_move_constructible_v<Value>)
+    {
+        assert(this->complete());
+        Value v(std::move(*root_));
+        root_.reset();
+        return v;
+    }
+
+private:
+    template<class... Args>
+    Value& emplace_node(Args&&... args)
+    {
+        if (stack_.empty()) {
+            assert(!root_.has_value());
+            return root_.emplace(std::forward<Args>(args)...);
+        }
+        return yk::visit([&, this]<class Container>(Container* const c) -> Value& {
+            return this->insert_into(*c, std::forward<Args>(args)...);
+        }, stack_.back());
+    }
+
+    template<class Container, class... Args>
+    Value& insert_into(Container& c, Args&&... args)
+    {
+        if constexpr (detail::tree_map_like<Container>) {
+            auto [it, inserted] = c.try_emplace(typename Container::key_type(key_), std::forward<Args>(args)...);
+            if (!inserted) {
+                it->second = Value(std::forward<Args>(args)...); // duplicate key; the last one wins
+            }
+            return it->second;
+
+        } else if constexpr (detail::tree_pair_sequence<Container>) {
+            return c.emplace_back(
+                std::piecewise_construct,
+                std::forward_as_tuple(key_),
+                std::forward_as_tuple(std::forward<Args>(args)...)
+            ).second;
+
+        } else {
+            return c.emplace_back(std::forward<Args>(args)...);
+        }
+    }
+
+    std::pmr::memory_resource* mr_ = std::pmr::get_default_resource();
+    std::optional<Value> root_;
+    std::pmr::vector<frame_type> stack_{mr_};
+    std::string_view key_;
+};
+
+} // yk
+
+#endif
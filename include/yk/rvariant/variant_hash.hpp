@@ -0,0 +1,283 @@
+﻿#ifndef YK_RVARIANT_VARIANT_HASH_HPP
+#define YK_RVARIANT_VARIANT_HASH_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Pluggable hashers, and transparent hash and equality for hash maps keyed by rvariant
+
+#include <yk/rvariant/rvariant.hpp>
+#include <yk/core/config.hpp>
+#include <yk/core/type_traits.hpp>
+#include <yk/core/hash.hpp>
+#include <yk/hash.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yk {
+
+// Specialize this to `std::true_type` if, for equal values `t` of type `T`
+// and `k` of type `K`, `std::hash<T>{}(t) == std::hash<K>{}(k)` holds and
+// `t == k` is well-formed.
+template<class T, class K>
+struct is_hash_compatible : std::is_same<T, K> {};
+
+// https://eel.is/c++draft/basic.string.hash
+template<class charT, class Traits, class Allocator>
+struct is_hash_compatible<std::basic_string<charT, Traits, Allocator>, std::basic_string_view<charT, Traits>> : std::true_type {};
+
+template<class T, class K>
+inline constexpr bool is_hash_compatible_v = is_hash_compatible<T, K>::value;
+
+namespace detail {
+
+template<class charT>
+concept transparent_char =
+    std::is_same_v<charT, char> || std::is_same_v<charT, wchar_t> ||
+    std::is_same_v<charT, char8_t> || std::is_same_v<charT, char16_t> || std::is_same_v<charT, char32_t>;
+
+// Null-terminated strings are probed as string views, since
+// `std::hash<charT const*>` hashes the pointer value.
+template<class K>
+struct transparent_key
+{
+    using type = K;
+};
+
+template<transparent_char charT>
+struct transparent_key<charT*>
+{
+    using type = std::basic_string_view<charT>;
+};
+
+template<transparent_char charT>
+struct transparent_key<charT const*>
+{
+    using type = std::basic_string_view<charT>;
+};
+
+template<transparent_char charT, std::size_t N>
+struct transparent_key<charT[N]>
+{
+    using type = std::basic_string_view<charT>;
+};
+
+template<class K>
+using transparent_key_t = typename transparent_key<std::remove_cvref_t<K>>::type;
+
+template<class Key, class... Ts>
+[[nodiscard]] consteval std::size_t hash_compatible_index() noexcept
+{
+    constexpr bool compatible[]{is_hash_compatible_v<unwrap_recursive_t<Ts>, Key>...};
+    std::size_t found = std::variant_npos;
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (!compatible[i]) continue;
+        if (found != std::variant_npos) return std::variant_npos; // ambiguous
+        found = i;
+    }
+    return found;
+}
+
+template<class Variant, class K>
+struct transparent_probe {};
+
+// `K` is hash-compatible with exactly one alternative; hashed as is
+template<class... Ts, class K>
+    requires (detail::hash_compatible_index<transparent_key_t<K>, Ts...>() != std::variant_npos)
+struct transparent_probe<rvariant<Ts...>, K>
+{
+    static constexpr std::size_t index = detail::hash_compatible_index<transparent_key_t<K>, Ts...>();
+    using key_type = transparent_key_t<K>;
+};
+
+// Otherwise, `K` is converted to the alternative selected by the converting constructor
+template<class... Ts, class K>
+    requires
+        (detail::hash_compatible_index<transparent_key_t<K>, Ts...>() == std::variant_npos) &&
+        requires { core::aggregate_initialize_resolution<K const&, Ts...>::index; }
+struct transparent_probe<rvariant<Ts...>, K>
+{
+    static constexpr std::size_t index = core::aggregate_initialize_resolution<K const&, Ts...>::index;
+    using key_type = unwrap_recursive_t<typename core::aggregate_initialize_resolution<K const&, Ts...>::type>;
+};
+
+template<class Variant, class K>
+concept transparent_probeable =
+    (!std::is_same_v<std::remove_cvref_t<K>, Variant>) &&
+    requires { transparent_probe<Variant, std::remove_cvref_t<K>>::index; };
+
+template<class Key, class K>
+[[nodiscard]] constexpr decltype(auto) as_transparent_key(K const& k)
+{
+    if constexpr (std::is_same_v<Key, K>) {
+        return (k);
+    } else {
+        return Key(k);
+    }
+}
+
+template<class Variant, class K>
+[[nodiscard]] constexpr bool transparent_equal(Variant const& v, K const& k)
+{
+    using probe = transparent_probe<Variant, K>;
+    auto const* const alt = yk::get_if<probe::index>(&v);
+    return alt != nullptr && *alt == detail::as_transparent_key<typename probe::key_type>(k);
+}
+
+} // detail
+
+
+// Mixers combine the hash of the contained alternative with its index.
+// A mixer `m` shall provide `m.template mix<I>(alt_hash)`.
+
+// The mixing of `std::hash<rvariant>`
+struct index_mixer
+{
+    template<std::size_t I>
+    [[nodiscard]] constexpr std::size_t mix(std::size_t const alt_hash) const noexcept
+    {
+        return detail::variant_hash_mix<I>(alt_hash);
+    }
+};
+
+// Applies a 64-bit (or 32-bit) avalanche finalizer to the result of
+// `index_mixer`, so that identity hashes of integral alternatives (as in
+// libstdc++ and libc++) do not form sequential clusters in the low bits.
+// Suitable for power-of-two sized open addressing tables.
+struct avalanche_mixer
+{
+    constexpr avalanche_mixer() noexcept = default;
+
+    constexpr explicit avalanche_mixer(std::size_t const seed) noexcept
+        : seed(seed)
+    {}
+
+    template<std::size_t I>
+    [[nodiscard]] constexpr std::size_t mix(std::size_t const alt_hash) const noexcept
+    {
+        return ::yk::detail::hash_mix<sizeof(std::size_t)>(seed ^ detail::variant_hash_mix<I>(alt_hash));
+    }
+
+    std::size_t seed = 0;
+};
+
+// A seed which is fixed during the lifetime of the process but likely
+// differs across executions (ASLR and startup time).
+[[nodiscard]] inline std::size_t process_hash_seed() noexcept
+{
+    static std::size_t const seed = ::yk::detail::hash_mix<sizeof(std::size_t)>(
+        static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(&seed)) ^
+        static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+    );
+    return seed;
+}
+
+struct seeded_avalanche_mixer : avalanche_mixer
+{
+    seeded_avalanche_mixer() noexcept
+        : avalanche_mixer(process_hash_seed())
+    {}
+};
+
+
+// Hasher for any specialization of `rvariant` with a pluggable `Mixer`.
+// `rvariant_hasher<index_mixer>` is equivalent to `std::hash<rvariant<Ts...>>`.
+template<class Mixer = avalanche_mixer>
+struct rvariant_hasher
+{
+    template<class... Ts>
+        requires std::conjunction_v<core::is_hash_enabled<std::remove_const_t<Ts>>...>
+    [[nodiscard]] std::size_t operator()(rvariant<Ts...> const& v) const
+        noexcept(std::conjunction_v<core::is_nothrow_hashable<std::remove_const_t<Ts>>...>)
+    {
+        return detail::raw_visit(v, [this]<std::size_t i, class T>(std::in_place_index_t<i>, T const& t)
+            noexcept(std::disjunction_v<
+                std::bool_constant<i == std::variant_npos>,
+                core::is_nothrow_hashable<T>
+            >)
+        {
+            if constexpr (i == std::variant_npos) {
+                (void)t;
+                return 0xbaddeadbeefuz; // same as `std::hash<rvariant>`
+            } else {
+                return mixer.template mix<i>(std::hash<T>{}(t));
+            }
+        });
+    }
+
+    YK_NO_UNIQUE_ADDRESS Mixer mixer{};
+};
+
+
+// Transparent hasher consistent with `rvariant_hasher<Mixer>` (by default,
+// with `std::hash<Variant>`); i.e., for a value `k` equal to the alternative
+// of `v`, `variant_hash<Variant>{}(k)` equals `std::hash<Variant>{}(v)`
+// without constructing `Variant`.
+//
+// `k` may be of a type which is hash-compatible (see `is_hash_compatible`)
+// with exactly one alternative, a null-terminated string (probed as a
+// string view), or a type which is convertible to an alternative.
+template<class Variant, class Mixer = index_mixer>
+struct variant_hash
+{
+    static_assert(core::is_ttp_specialization_of_v<Variant, rvariant>);
+
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(Variant const& v) const
+        noexcept(noexcept(rvariant_hasher<Mixer>{}(v)))
+    {
+        return rvariant_hasher<Mixer>{mixer}(v);
+    }
+
+    template<class K>
+        requires detail::transparent_probeable<Variant, K>
+    [[nodiscard]] std::size_t operator()(K const& k) const
+    {
+        using probe = detail::transparent_probe<Variant, K>;
+        using Key = typename probe::key_type;
+        return mixer.template mix<probe::index>(std::hash<Key>{}(detail::as_transparent_key<Key>(k)));
+    }
+
+    YK_NO_UNIQUE_ADDRESS Mixer mixer{};
+};
+
+template<class Variant>
+struct variant_equal_to
+{
+    static_assert(core::is_ttp_specialization_of_v<Variant, rvariant>);
+
+    using is_transparent = void;
+
+    [[nodiscard]] constexpr bool operator()(Variant const& a, Variant const& b) const
+    {
+        return a == b;
+    }
+
+    template<class K>
+        requires detail::transparent_probeable<Variant, K>
+    [[nodiscard]] constexpr bool operator()(Variant const& v, K const& k) const
+    {
+        return detail::transparent_equal(v, k);
+    }
+
+    template<class K>
+        requires detail::transparent_probeable<Variant, K>
+    [[nodiscard]] constexpr bool operator()(K const& k, Variant const& v) const
+    {
+        return detail::transparent_equal(v, k);
+    }
+};
+
+} // yk
+
+#endif
@@ -51,12 +51,104 @@ using variant_index_t = typename variant_index_selector<VariantSize>::type;
 template<std::size_t VariantSize>
 inline constexpr variant_index_t<VariantSize> variant_npos = static_cast<variant_index_t<VariantSize>>(-1);
 
+// Default size limit for never valueless trivial alternatives
+inline constexpr std::size_t never_valueless_trivial_size_limit = 256;
+
 template<std::size_t I, class T>
 struct alternative;
 
 } // detail
 
 
+// Per-alternative-set customization point for the storage decisions of `rvariant<Ts...>`.
+// Users may specialize this for a specific set of alternatives; a member which is
+// not provided by a specialization takes the default of the primary template.
+// The specialization must be declared before any use of `rvariant<Ts...>`, in the
+// header that names the type list; see `detail::rvariant_policy_traits`.
+template<class... Ts>
+struct rvariant_policy
+{
+    // Integral type of the stored index. Must be able to represent `sizeof...(Ts)`;
+    // the valueless state is represented by `static_cast<index_type>(-1)`.
+    using index_type = detail::variant_index_t<sizeof...(Ts)>;
+
+    // Trivial alternatives up to this size are treated as never valueless, i.e.
+    // a throwing `emplace` constructs a temporary and then copies it into the storage.
+    static constexpr std::size_t never_valueless_trivial_size_limit = detail::never_valueless_trivial_size_limit;
+
+    // If `true`, alternatives with a non-throwing move constructor are also treated as
+    // never valueless; a throwing `emplace` constructs a temporary and then moves it into
+    // the storage. This trades an extra move on such `emplace` for the removal of the
+    // valueless state (and its branch) from every visitation.
+    static constexpr bool nothrow_move_never_valueless = false;
+};
+
+namespace detail {
+
+template<class Policy, class Default>
+struct policy_index_type
+{
+    using type = Default;
+};
+
+template<class Policy, class Default>
+    requires requires { typename Policy::index_type; }
+struct policy_index_type<Policy, Default>
+{
+    using type = typename Policy::index_type;
+};
+
+// Reads the members of `rvariant_policy<Ts...>`, falling back to the
+// defaults of the primary template for missing members.
+// `rvariant_policy<Ts...>` is instantiated unconditionally (not only through the
+// member checks below, which never fail), so that a specialization declared after
+// the first use of `rvariant<Ts...>` in the same TU is diagnosed by the compiler as
+// a specialization after instantiation instead of being silently ignored.
+template<class... Ts>
+struct rvariant_policy_traits
+{
+    using policy_type = rvariant_policy<Ts...>;
+
+    static_assert(sizeof(policy_type) != 0, "rvariant_policy<Ts...> must be a complete type");
+
+    using index_type = typename policy_index_type<policy_type, variant_index_t<sizeof...(Ts)>>::type;
+
+    static constexpr std::size_t never_valueless_trivial_size_limit = [] {
+        if constexpr (requires { policy_type::never_valueless_trivial_size_limit; }) {
+            return static_cast<std::size_t>(policy_type::never_valueless_trivial_size_limit);
+        } else {
+            return detail::never_valueless_trivial_size_limit;
+        }
+    }();
+
+    static constexpr bool nothrow_move_never_valueless = [] {
+        if constexpr (requires { policy_type::nothrow_move_never_valueless; }) {
+            return static_cast<bool>(policy_type::nothrow_move_never_valueless);
+        } else {
+            return false;
+        }
+    }();
+};
+
+template<class... Ts>
+struct rvariant_index
+{
+    using type = typename rvariant_policy_traits<Ts...>::index_type;
+
+    static_assert(std::is_integral_v<type> && !std::is_same_v<std::remove_cv_t<type>, bool>, "rvariant_policy<Ts...>::index_type must be an integral type");
+    static_assert(std::in_range<type>(sizeof...(Ts)), "rvariant_policy<Ts...>::index_type is too narrow for the number of alternatives");
+};
+
+template<class... Ts>
+using rvariant_index_t = typename rvariant_index<Ts...>::type;
+
+// Same as `variant_npos`, but for the index type selected by `rvariant_policy<Ts...>`
+template<class... Ts>
+inline constexpr rvariant_index_t<Ts...> rvariant_npos = static_cast<rvariant_index_t<Ts...>>(-1);
+
+} // detail
+
+
 template<class Variant>
 struct variant_size;
 
@@ -105,6 +197,23 @@ struct variant_alternative<I, rvariant<Ts...>> : core::pack_indexing<I, unwrap_r
     static_assert(I < sizeof...(Ts));
 };
 
+namespace detail {
+
+// The alternative as declared; i.e. `recursive_wrapper` is not unwrapped
+template<std::size_t I, class Variant>
+struct raw_alternative;
+
+template<std::size_t I, class Variant>
+using raw_alternative_t = typename raw_alternative<I, Variant>::type;
+
+template<std::size_t I, class... Ts>
+struct raw_alternative<I, rvariant<Ts...>> : core::pack_indexing<I, Ts...>
+{
+    static_assert(I < sizeof...(Ts));
+};
+
+} // detail
+
 
 template<class... Fs>
 struct overloaded : Fs...
@@ -113,6 +222,41 @@ struct overloaded : Fs...
 };
 
 
+// Tag for constructing an alternative directly from the result of a callable
+struct from_invoke_t
+{
+    constexpr explicit from_invoke_t() = default;
+};
+
+inline constexpr from_invoke_t from_invoke{};
+
+namespace detail {
+
+// A prvalue of `T` initializes `T` without any constructor (guaranteed copy elision),
+// which `std::is_constructible<T, T>` cannot express for non-movable types.
+template<class T, class R>
+struct is_result_constructible : std::disjunction<std::is_same<T, std::remove_cv_t<R>>, std::is_constructible<T, R>> {};
+
+template<class T, class R>
+struct is_nothrow_result_constructible : std::disjunction<std::is_same<T, std::remove_cv_t<R>>, std::is_nothrow_constructible<T, R>> {};
+
+template<class T, class F>
+struct is_invoke_constructible : std::false_type {};
+
+template<class T, class F>
+    requires std::is_invocable_v<F>
+struct is_invoke_constructible<T, F> : is_result_constructible<T, std::invoke_result_t<F>> {};
+
+template<class T, class F>
+struct is_nothrow_invoke_constructible : std::false_type {};
+
+template<class T, class F>
+    requires std::is_nothrow_invocable_v<F>
+struct is_nothrow_invoke_constructible<T, F> : is_nothrow_result_constructible<T, std::invoke_result_t<F>> {};
+
+} // detail
+
+
 namespace detail {
 
 template<class VT, class RHS>
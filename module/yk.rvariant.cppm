@@ -0,0 +1,81 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Module interface for `<yk/rvariant.hpp>`.
+// The headers are attached to the global module; this unit only re-exports
+// their public names, so that `#include` and `import` can coexist in a program.
+
+module;
+
+#include <yk/rvariant.hpp>
+
+export module yk.rvariant;
+
+export namespace yk {
+
+// [rvariant.rvariant]
+using yk::rvariant;
+
+// [rvariant.recursive]
+using yk::recursive_wrapper;
+
+// [rvariant.policy]
+using yk::rvariant_policy;
+
+// [rvariant.helper]
+using yk::variant_size;
+using yk::variant_size_v;
+using yk::variant_alternative;
+using yk::variant_alternative_t;
+using yk::unwrap_recursive;
+using yk::unwrap_recursive_t;
+
+// [rvariant.ctor]
+using yk::from_invoke_t;
+using yk::from_invoke;
+using yk::for_overwrite_t;
+using yk::for_overwrite;
+using yk::is_for_overwrite_constructible;
+using yk::is_for_overwrite_constructible_v;
+
+// [rvariant.get]
+using yk::holds_alternative;
+using yk::get;
+using yk::get_if;
+
+// [rvariant.visit]
+using yk::visit;
+using yk::visit_commutative;
+using yk::visit_same;
+using yk::visit_some;
+using yk::overloaded;
+
+// relational operators
+using yk::operator==;
+using yk::operator!=;
+using yk::operator<;
+using yk::operator>;
+using yk::operator<=;
+using yk::operator>=;
+using yk::operator<=>;
+
+// [rvariant.hash]
+using yk::hash_value;
+using yk::hash_combine;
+
+// [rvariant.pack]
+using yk::compact_alternative;
+using yk::compact_alternative_t;
+
+} // yk
+
+export namespace yk::rvariant_set {
+
+// [rvariant.flex]
+using yk::rvariant_set::is_subset_of;
+using yk::rvariant_set::is_subset_of_v;
+using yk::rvariant_set::subset_of;
+using yk::rvariant_set::equivalent_to;
+
+} // yk::rvariant_set
@@ -0,0 +1,28 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Module interface for `<yk/rvariant/rvariant_io.hpp>`.
+// Kept separate from `yk.rvariant` for the same reason as the header:
+// `<format>` and `<ostream>` are expensive and not needed by every user.
+
+module;
+
+#include <yk/rvariant/rvariant_io.hpp>
+
+export module yk.rvariant.io;
+
+export import yk.rvariant;
+
+export namespace yk {
+
+// [rvariant.io.ostream]
+using yk::operator<<;
+using yk::write_all;
+
+// [rvariant.io.format]
+using yk::variant_format;
+using yk::variant_format_for;
+using yk::format_by;
+
+} // yk
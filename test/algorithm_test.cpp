@@ -0,0 +1,343 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "rvariant_test.hpp"
+
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/algorithm.hpp"
+#include "yk/rvariant/recursive_wrapper.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace unit_test {
+
+TEST_CASE("equal")
+{
+    {
+        using V = yk::rvariant<int, unsigned>;
+        STATIC_REQUIRE(yk::detail::bitwise_equal_ranges<std::vector<V>&, std::vector<V> const&>);
+
+        std::vector<V> a, b;
+        for (std::size_t i = 0; i < 100; ++i) {
+            if (i % 3 == 0) {
+                a.emplace_back(static_cast<unsigned>(i));
+            } else {
+                a.emplace_back(static_cast<int>(i));
+            }
+        }
+        b = a;
+        CHECK(yk::equal(a, b));
+        CHECK(yk::equal(std::span{a}.first(17), std::span{b}.first(17)));
+        CHECK(!yk::equal(std::span{a}.first(17), std::span{b}.first(18)));
+
+        for (std::size_t i : {0uz, 15uz, 16uz, 99uz}) {
+            auto c = a;
+            c[i] = i % 3 == 0 ? V{static_cast<int>(i)} : V{static_cast<unsigned>(i)};  // same value, different index
+            CHECK(!yk::equal(a, c));
+            c[i] = a[i];
+            CHECK(yk::equal(a, c));
+            c[i] = V{1000};
+            CHECK(!yk::equal(a, c));
+        }
+
+        std::list<V> const l(a.begin(), a.end());
+        CHECK(yk::equal(a, l));
+    }
+    {
+        // non-uniform size; falls back to std::ranges::equal
+        using V = yk::rvariant<int, std::string>;
+        STATIC_REQUIRE(!yk::detail::bitwise_equal_ranges<std::vector<V>&, std::vector<V>&>);
+
+        std::vector<V> const a{1, "foo", 2}, b{1, "foo", 2}, c{1, "bar", 2};
+        CHECK(yk::equal(a, b));
+        CHECK(!yk::equal(a, c));
+    }
+    {
+        using V = yk::rvariant<int, unsigned>;
+        constexpr std::array<V, 3> a{V{1}, V{2u}, V{3}};
+        STATIC_CHECK(yk::equal(a, a));
+    }
+}
+
+namespace {
+
+template<std::size_t Size>
+struct Padded
+{
+    unsigned char data[Size]{};
+};
+
+// The expected results are computed with `index()`
+template<class V>
+void check_index_algorithms(std::vector<V> const& vars)
+{
+    constexpr std::size_t N = yk::variant_size_v<V>;
+
+    auto const hist = yk::index_histogram(vars);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i <= N; ++i) {
+        std::size_t const index = i < N ? i : std::variant_npos;
+        auto const expected = static_cast<std::size_t>(std::ranges::count_if(vars, [&](V const& v) { return v.index() == index; }));
+        CHECK(hist[i] == expected);
+        CHECK(yk::count_index(vars, index) == expected);
+        total += hist[i];
+
+        auto const it = yk::find_index(vars, index);
+        CHECK(it == std::ranges::find_if(vars, [&](V const& v) { return v.index() == index; }));
+
+        std::vector<std::size_t> positions;
+        yk::indices_of(vars, index, std::back_inserter(positions));
+        REQUIRE(positions.size() == expected);
+        for (std::size_t const pos : positions) {
+            CHECK(vars[pos].index() == index);
+        }
+        CHECK(std::ranges::is_sorted(positions));
+    }
+    CHECK(total == vars.size());
+}
+
+template<class V>
+void check_index_algorithms_for_sizes()
+{
+    for (std::size_t n : {0uz, 1uz, 7uz, 8uz, 9uz, 16uz, 17uz, 100uz}) {
+        std::vector<V> vars;
+        for (std::size_t k = 0; k < n; ++k) {
+            switch (k * 7 % 5) {
+            case 0: case 3: vars.emplace_back(std::in_place_index<0>); break;
+            case 1: vars.emplace_back(std::in_place_index<1>); break;
+            default: vars.emplace_back(std::in_place_index<2>); break;
+            }
+        }
+        check_index_algorithms(vars);
+    }
+}
+
+} // anonymous
+
+TEST_CASE("index algorithms")
+{
+    check_index_algorithms_for_sizes<yk::rvariant<char, bool, unsigned char>>();
+    check_index_algorithms_for_sizes<yk::rvariant<int, float, Padded<3>>>();
+    check_index_algorithms_for_sizes<yk::rvariant<int, double, Padded<12>>>();
+    check_index_algorithms_for_sizes<yk::rvariant<int, double, Padded<24>>>();
+    check_index_algorithms_for_sizes<yk::rvariant<int, double, Padded<56>>>();
+
+    {
+        using V = yk::rvariant<int, MC_Thrower>;
+        std::vector<V> vars(20);
+        vars[3] = make_valueless<int>();
+        vars[12] = make_valueless<int>();
+        vars[19].emplace<1>();
+        check_index_algorithms(vars);
+        CHECK(yk::count_index(vars, std::variant_npos) == 2);
+        CHECK(yk::index_histogram(vars)[2] == 2);
+        CHECK(yk::find_index(vars, std::variant_npos) == vars.begin() + 3);
+    }
+    {
+        // non-contiguous
+        using V = yk::rvariant<int, float>;
+        std::list<V> const l{V{1}, V{1.0f}, V{2}};
+        CHECK(yk::count_index(l, 0) == 2);
+        CHECK(yk::index_histogram(l) == std::array<std::size_t, 3>{2, 1, 0});
+        CHECK(yk::find_index(l, 1) == std::next(l.begin()));
+        std::vector<std::size_t> positions;
+        yk::indices_of(l, 0, std::back_inserter(positions));
+        CHECK(positions == std::vector<std::size_t>{0, 2});
+    }
+    {
+        using V = yk::rvariant<int, float>;
+        constexpr std::array<V, 3> a{V{1}, V{1.0f}, V{2}};
+        STATIC_CHECK(yk::count_index(a, 0) == 2);
+        STATIC_CHECK(yk::find_index(a, 1) == a.begin() + 1);
+    }
+    {
+        // out-of-range indices must not wrap around the 1-byte index
+        using V = yk::rvariant<int, float>;
+        std::vector<V> const vars(20, V{1});
+        for (std::size_t const i : {2uz, 256uz, 257uz, std::size_t{std::numeric_limits<std::uint32_t>::max()}}) {
+            CHECK(yk::count_index(vars, i) == 0);
+            CHECK(yk::find_index(vars, i) == vars.end());
+            std::vector<std::size_t> positions;
+            yk::indices_of(vars, i, std::back_inserter(positions));
+            CHECK(positions.empty());
+        }
+        std::list<V> const l(vars.begin(), vars.end());
+        CHECK(yk::count_index(l, 256) == 0);
+        CHECK(yk::find_index(l, 256) == l.end());
+    }
+}
+
+namespace {
+
+// Each element is tagged with its original position
+using SortV = yk::rvariant<int, std::string, double>;
+
+[[nodiscard]] std::vector<SortV> make_sort_input(std::size_t const n)
+{
+    std::vector<SortV> vars;
+    for (std::size_t k = 0; k < n; ++k) {
+        switch (k * 7 % 5) {
+        case 0: case 3: vars.emplace_back(std::in_place_index<0>, static_cast<int>(k)); break;
+        case 1: vars.emplace_back(std::in_place_index<1>, std::string(32, 'a') + std::to_string(k)); break;
+        default: vars.emplace_back(std::in_place_index<2>, static_cast<double>(k)); break;
+        }
+    }
+    return vars;
+}
+
+template<class V, std::size_t M>
+void check_bounds(std::vector<V> const& vars, std::array<std::size_t, M> const& bounds)
+{
+    constexpr std::size_t N = yk::variant_size_v<V>;
+    STATIC_REQUIRE(M == N + 2);
+    CHECK(bounds.front() == 0);
+    CHECK(bounds.back() == vars.size());
+    for (std::size_t b = 0; b <= N; ++b) {
+        for (std::size_t k = bounds[b]; k < bounds[b + 1]; ++k) {
+            CHECK(vars[k].index() == (b < N ? b : std::variant_npos));
+        }
+    }
+}
+
+} // anonymous
+
+TEST_CASE("partition_by_index")
+{
+    for (std::size_t n : {0uz, 1uz, 2uz, 10uz, 100uz}) {
+        auto const original = make_sort_input(n);
+        auto vars = original;
+        auto const bounds = yk::partition_by_index(vars);
+        check_bounds(vars, bounds);
+
+        // is a permutation
+        CHECK(std::ranges::is_permutation(vars, original));
+    }
+    {
+        // trivially copyable
+        using V = yk::rvariant<int, float>;
+        std::vector<V> vars{V{1}, V{1.0f}, V{2}, V{2.0f}, V{3}};
+        auto const bounds = yk::partition_by_index(vars);
+        check_bounds(vars, bounds);
+        CHECK(bounds == std::array<std::size_t, 4>{0, 3, 5, 5});
+    }
+    {
+        using V = yk::rvariant<int, MC_Thrower>;
+        std::vector<V> vars(10);
+        vars[0] = make_valueless<int>();
+        vars[4] = make_valueless<int>();
+        auto const bounds = yk::partition_by_index(vars);
+        check_bounds(vars, bounds);
+        CHECK(bounds == std::array<std::size_t, 4>{0, 8, 8, 10});
+    }
+}
+
+TEST_CASE("counting_sort_by_index")
+{
+    for (std::size_t n : {0uz, 1uz, 2uz, 10uz, 100uz}) {
+        auto const original = make_sort_input(n);
+        auto vars = original;
+        auto const bounds = yk::counting_sort_by_index(vars);
+        check_bounds(vars, bounds);
+
+        // stable
+        auto expected = original;
+        std::ranges::stable_sort(expected, {}, [](SortV const& v) { return v.index(); });
+        CHECK(vars == expected);
+    }
+    {
+        // trivially copyable
+        using V = yk::rvariant<int, float>;
+        STATIC_REQUIRE(std::is_trivially_copyable_v<V>);
+        std::vector<V> vars{V{1}, V{1.0f}, V{2}, V{2.0f}, V{3}};
+        auto const bounds = yk::counting_sort_by_index(vars);
+        CHECK(bounds == std::array<std::size_t, 4>{0, 3, 5, 5});
+        CHECK(vars == std::vector<V>{V{1}, V{2}, V{3}, V{1.0f}, V{2.0f}});
+    }
+    {
+        using V = yk::rvariant<int, MC_Thrower>;
+        std::vector<V> vars(10);
+        for (std::size_t k = 0; k < vars.size(); ++k) vars[k] = static_cast<int>(k);
+        vars[0] = make_valueless<int>();
+        vars[4] = make_valueless<int>();
+        auto const bounds = yk::counting_sort_by_index(vars);
+        check_bounds(vars, bounds);
+        CHECK(bounds == std::array<std::size_t, 4>{0, 8, 8, 10});
+        CHECK(vars[0] == V{1});
+        CHECK(vars[3] == V{5});
+    }
+    {
+        // non-contiguous
+        std::deque<SortV> vars{SortV{1.0}, SortV{"foo"}, SortV{1}, SortV{2.0}, SortV{2}};
+        auto const bounds = yk::counting_sort_by_index(vars);
+        CHECK(bounds == std::array<std::size_t, 5>{0, 2, 3, 5, 5});
+        CHECK(std::ranges::equal(vars, std::deque<SortV>{SortV{1}, SortV{2}, SortV{"foo"}, SortV{1.0}, SortV{2.0}}));
+    }
+}
+
+TEST_CASE("convert_range")
+{
+    {
+        using From = yk::rvariant<int, char>;
+        using To = yk::rvariant<double, char, long long, int>;
+        STATIC_REQUIRE(yk::detail::is_bitwise_convertible<From, To>::value);
+
+        std::vector<From> src;
+        for (int k = 0; k < 50; ++k) {
+            if (k % 3 == 0) {
+                src.emplace_back(static_cast<char>('a' + k % 26));
+            } else {
+                src.emplace_back(k);
+            }
+        }
+
+        std::vector<To> dst(src.size(), To{3.14});
+        auto const it = yk::convert_range<To>(src, dst.begin());
+        CHECK(it == dst.end());
+        for (std::size_t k = 0; k < src.size(); ++k) {
+            CHECK(dst[k] == To(src[k]));
+        }
+    }
+    {
+        // not trivially copyable, or wrapped in `To`
+        using From = yk::rvariant<int, std::string>;
+        using To = yk::rvariant<double, yk::recursive_wrapper<std::string>, int>;
+        STATIC_REQUIRE(!yk::detail::is_bitwise_convertible<From, To>::value);
+
+        std::vector<From> const src{1, "foo", 2};
+        std::vector<To> dst;
+        yk::convert_range<To>(src, std::back_inserter(dst));
+        REQUIRE(dst.size() == 3);
+        CHECK(dst[0] == To{1});
+        CHECK(dst[1] == To{std::string("foo")});
+        CHECK(dst[2] == To{2});
+    }
+    {
+        using From = yk::rvariant<int, char>;
+        using To = yk::rvariant<char, int>;
+        static constexpr std::array<From, 2> src{From{1}, From{'a'}};
+        constexpr auto dst = [] {
+            std::array<To, 2> dst{};
+            yk::convert_range<To>(src, dst.begin());
+            return dst;
+        }();
+        STATIC_CHECK(dst[0] == To{1});
+        STATIC_CHECK(dst[1] == To{'a'});
+    }
+}
+
+} // unit_test
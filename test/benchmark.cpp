@@ -5,22 +5,65 @@
 #include "benchmark_support.hpp"
 
 #include <yk/rvariant/rvariant.hpp>
+#include <yk/rvariant/rvariant_io.hpp>
+#include <yk/rvariant/rvariant_parse.hpp>
+#include <yk/rvariant/tree_builder.hpp>
+#include <yk/rvariant/recursive_wrapper_pmr.hpp>
+#include <yk/rvariant/variant_hash.hpp>
+#include <yk/rvariant/algorithm.hpp>
+#include <yk/rvariant/mailbox.hpp>
+#include <yk/rvariant/shared_rvariant.hpp>
+#include <yk/rvariant/parallel_tree.hpp>
+#include <yk/rvariant/parallel_visit.hpp>
 
 #include <yk/default_init_allocator.hpp>
 
 #include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <iterator>
+#include <string>
 #include <ranges>
 #include <utility>
 #include <charconv>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <bit>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <deque>
 #include <print>
 #include <chrono>
 #include <vector>
 #include <variant>
 #include <random>
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 
+namespace benchmark::nothrow_move {
+
+// Distinguishes otherwise identical alternative sets so that only one of them opts in
+template<bool OptIn>
+struct tag {};
+
+template<bool OptIn>
+using V = yk::rvariant<int, std::string, std::vector<int>, tag<OptIn>>;
+
+} // benchmark::nothrow_move
+
+template<>
+struct yk::rvariant_policy<int, std::string, std::vector<int>, benchmark::nothrow_move::tag<true>>
+{
+    static constexpr bool nothrow_move_never_valueless = true;
+};
+
 namespace benchmark {
 
 namespace {
@@ -102,6 +145,29 @@ struct Table
     }
 };
 
+// Benchmarks which have no std::variant counterpart
+struct Report
+{
+    explicit Report(std::string title)
+        : title(std::move(title))
+    {}
+
+    std::string title;
+    std::size_t N{};
+    Table::EntryList entries;
+
+    std::string make_csv() const
+    {
+        std::string csv;
+        csv += std::format("{} | N={},ms\n", title, N);
+
+        for (auto const& [key, duration] : entries) {
+            csv += std::format("{},{}\n", key, duration.count());
+        }
+        return csv;
+    }
+};
+
 template<class T, class Vars>
 void benchmark_construct_3(Table::EntryList& entries, std::size_t const N, Vars& vars)
 {
@@ -361,173 +427,1484 @@ void benchmark_operator(Table::EntryList& entries, std::size_t const N, Vars con
     disable_optimization(sum);
 }
 
-template<class T>
-void do_bench(Table& table_3, Table& table_16, std::size_t const N)
+void benchmark_format(Report& report, std::size_t const N)
 {
-    table_3.N = N;
-    table_16.N = N;
+    using V = yk::rvariant<int, double, std::string>;
+    report.N = N;
 
-    {
-        constexpr std::size_t AltN = 3;
-        table_3.AltN = AltN;
+    std::random_device rd;
 
-        {
-            using V = many_V_t<std::variant, AltN, T>;
-            auto& entries = table_3.std_datas;
+    std::uniform_int_distribution<std::size_t> I_dist(0, 3 - 1);
+    REng I_eng(rd());
 
-            std::vector<V, yk::default_init_allocator<V>> vars;
-            benchmark_construct_3<T>(entries, N, vars);
-            benchmark_copy_assign(entries, N, vars);
+    std::uniform_int_distribution<int> value_dist;
+    REng value_eng(rd());
 
-            benchmark_get_3(entries, N, vars);
-            benchmark_get_if_3(entries, N, vars);
-            benchmark_visit(entries, N, vars);
-            benchmark_multi_visit(entries, N, vars);
+    std::vector<V> vars;
+    vars.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int const value = value_dist(value_eng);
 
-            benchmark_operator<std::equal_to<>>(entries, N, vars);
-            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
-            benchmark_operator<std::less<>>(entries, N, vars);
-            benchmark_operator<std::greater<>>(entries, N, vars);
-            benchmark_operator<std::less_equal<>>(entries, N, vars);
-            benchmark_operator<std::greater_equal<>>(entries, N, vars);
-            benchmark_operator<std::compare_three_way>(entries, N, vars);
+        switch (I_dist(I_eng)) {
+        case 0: vars.emplace_back(std::in_place_index<0>, value); break;
+        case 1: vars.emplace_back(std::in_place_index<1>, value / 7.0); break;
+        case 2: vars.emplace_back(std::in_place_index<2>, std::to_string(value)); break;
+        default: std::unreachable();
         }
-        {
-            using V = many_V_t<yk::rvariant, AltN, T>;
-            auto& entries = table_3.rva_datas;
+    }
 
-            std::vector<V, yk::default_init_allocator<V>> vars;
-            benchmark_construct_3<T>(entries, N, vars);
-            benchmark_copy_assign(entries, N, vars);
+    auto const measure = [&](std::string key, auto&& format_one) {
+        std::size_t total_size = 0;
 
-            benchmark_get_3(entries, N, vars);
-            benchmark_get_if_3(entries, N, vars);
-            benchmark_visit(entries, N, vars);
-            benchmark_multi_visit(entries, N, vars);
+        auto const start_time = Clock::now();
+        for (auto const& v : vars) {
+            total_size += format_one(v);
+        }
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        report.entries.emplace_back(std::move(key), elapsed);
 
-            benchmark_operator<std::equal_to<>>(entries, N, vars);
-            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
-            benchmark_operator<std::less<>>(entries, N, vars);
-            benchmark_operator<std::greater<>>(entries, N, vars);
-            benchmark_operator<std::less_equal<>>(entries, N, vars);
-            benchmark_operator<std::greater_equal<>>(entries, N, vars);
-            benchmark_operator<std::compare_three_way>(entries, N, vars);
+        disable_optimization(total_size);
+    };
+
+    std::string buf;
+
+    {
+        std::ostringstream oss;
+        measure("operator<<", [&](V const& v) {
+            oss.str({});
+            oss << v;
+            return oss.view().size();
+        });
+    }
+    measure("std::format(visit)", [&](V const& v) {
+        buf = yk::visit([](auto const& x) { return std::format("{}", x); }, v);
+        return buf.size();
+    });
+    measure("visit + std::format_to", [&](V const& v) {
+        buf.clear();
+        yk::visit([&](auto const& x) { std::format_to(std::back_inserter(buf), "{}", x); }, v);
+        return buf.size();
+    });
+    {
+        constexpr auto v_fmt = yk::variant_format_for<V>("{}", "{}", "{}");
+        measure("format_by", [&](V const& v) {
+            buf.clear();
+            std::format_to(std::back_inserter(buf), "{}", yk::format_by(v_fmt, v));
+            return buf.size();
+        });
+    }
+    measure("formatter", [&](V const& v) {
+        buf.clear();
+        std::format_to(std::back_inserter(buf), "{}", v);
+        return buf.size();
+    });
+    {
+        constexpr auto v_fmt = yk::variant_format_for<V>("{:>16}", "{:>16}", "{:>16}");
+        measure("format_by {:>16}", [&](V const& v) {
+            buf.clear();
+            std::format_to(std::back_inserter(buf), "{}", yk::format_by(v_fmt, v));
+            return buf.size();
+        });
+    }
+    measure("formatter {:>16}", [&](V const& v) {
+        buf.clear();
+        std::format_to(std::back_inserter(buf), "{:>16}", v);
+        return buf.size();
+    });
+
+    // bulk output of the entire range
+    {
+        std::ostringstream oss;
+
+        auto const start_time = Clock::now();
+        for (auto const& v : vars) {
+            oss << v << ' ';
         }
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        report.entries.emplace_back("operator<< (range)", elapsed);
+
+        disable_optimization(oss);
     }
     {
-        constexpr std::size_t AltN = 16;
-        table_16.AltN = 16;
+        std::ostringstream oss;
 
-        {
-            using V = many_V_t<std::variant, AltN, T>;
-            auto& entries = table_16.std_datas;
+        auto const start_time = Clock::now();
+        yk::write_all(oss, vars, ' ');
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        report.entries.emplace_back("write_all (range)", elapsed);
 
-            std::vector<V, yk::default_init_allocator<V>> vars;
-            benchmark_construct_16<T>(entries, N, vars);
-            benchmark_copy_assign(entries, N, vars);
+        disable_optimization(oss);
+    }
+}
 
-            benchmark_get_16(entries, N, vars);
-            benchmark_get_if_16(entries, N, vars);
-            benchmark_visit(entries, N, vars);
-            benchmark_multi_visit(entries, N, vars);
+void benchmark_parse(Report& report, std::size_t const N)
+{
+    using V = yk::rvariant<std::monostate, std::int64_t, double, bool, std::string_view>;
+    report.N = N;
 
-            benchmark_operator<std::equal_to<>>(entries, N, vars);
-            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
-            benchmark_operator<std::less<>>(entries, N, vars);
-            benchmark_operator<std::greater<>>(entries, N, vars);
-            benchmark_operator<std::less_equal<>>(entries, N, vars);
-            benchmark_operator<std::greater_equal<>>(entries, N, vars);
-            benchmark_operator<std::compare_three_way>(entries, N, vars);
+    std::random_device rd;
+
+    std::uniform_int_distribution<std::size_t> I_dist(0, 5 - 1);
+    REng I_eng(rd());
+
+    std::uniform_int_distribution<int> value_dist;
+    REng value_eng(rd());
+
+    std::string text;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    ranges.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int const value = value_dist(value_eng);
+        std::size_t const pos = text.size();
+
+        switch (I_dist(I_eng)) {
+        case 0: break;
+        case 1: text += std::to_string(value); break;
+        case 2: text += std::format("{}", value / 7.0); break;
+        case 3: text += value % 2 == 0 ? "true" : "false"; break;
+        case 4: text += std::format("str{}", value); break;
+        default: std::unreachable();
         }
-        {
-            using V = many_V_t<yk::rvariant, AltN, T>;
-            auto& entries = table_16.rva_datas;
+        ranges.emplace_back(pos, text.size() - pos);
+    }
 
-            std::vector<V, yk::default_init_allocator<V>> vars;
-            benchmark_construct_16<T>(entries, N, vars);
-            benchmark_copy_assign(entries, N, vars);
+    std::vector<std::string_view> fields;
+    fields.reserve(N);
+    for (auto const& [pos, len] : ranges) {
+        fields.emplace_back(std::string_view{text}.substr(pos, len));
+    }
 
-            benchmark_get_16(entries, N, vars);
-            benchmark_get_if_16(entries, N, vars);
-            benchmark_visit(entries, N, vars);
-            benchmark_multi_visit(entries, N, vars);
+    std::vector<V> vars(N);
+    double const GB = static_cast<double>(text.size()) / 1e9;
 
-            benchmark_operator<std::equal_to<>>(entries, N, vars);
-            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
-            benchmark_operator<std::less<>>(entries, N, vars);
-            benchmark_operator<std::greater<>>(entries, N, vars);
-            benchmark_operator<std::less_equal<>>(entries, N, vars);
-            benchmark_operator<std::greater_equal<>>(entries, N, vars);
-            benchmark_operator<std::compare_three_way>(entries, N, vars);
+    auto const record = [&](std::string key, duration_type const elapsed) {
+        std::println("{}: {:.3f} GB/s", key, GB / (elapsed.count() / 1000));
+        report.entries.emplace_back(std::move(key), elapsed);
+        disable_optimization(vars);
+    };
+
+    {
+        // the baseline: parse into a temporary, then assign
+        auto const parse_tmp = [](std::string_view const str) -> V {
+            if (str.empty()) return std::monostate{};
+
+            char const* const last = str.data() + str.size();
+            {
+                std::int64_t value{};
+                if (auto const [ptr, ec] = std::from_chars(str.data(), last, value); ec == std::errc{} && ptr == last) return value;
+            }
+            {
+                double value{};
+                if (auto const [ptr, ec] = std::from_chars(str.data(), last, value); ec == std::errc{} && ptr == last) return value;
+            }
+            if (str == "true") return true;
+            if (str == "false") return false;
+            return str;
+        };
+
+        auto const start_time = Clock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            vars[i] = parse_tmp(fields[i]);
+        }
+        auto const end_time = Clock::now();
+        record("temporary + operator=", std::chrono::duration_cast<duration_type>(end_time - start_time));
+    }
+    {
+        auto const start_time = Clock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            (void)yk::parse_into(vars[i], fields[i]);
         }
+        auto const end_time = Clock::now();
+        record("parse_into", std::chrono::duration_cast<duration_type>(end_time - start_time));
+    }
+    {
+        auto const start_time = Clock::now();
+        std::size_t const n = yk::parse_all(fields, vars);
+        auto const end_time = Clock::now();
+        if (n != N) throw std::logic_error{"parse_all failed"};
+        record("parse_all", std::chrono::duration_cast<duration_type>(end_time - start_time));
     }
 }
 
-int benchmark_main(std::size_t const N)
+namespace tree {
+
+struct Array;
+using Value = yk::rvariant<double, yk::recursive_wrapper<Array>>;
+struct Array : std::vector<Value> { using vector::vector; };
+
+struct PmrArray;
+using PmrValue = yk::rvariant<double, yk::pmr::recursive_wrapper<PmrArray>>;
+struct PmrArray : std::pmr::vector<PmrValue> { using vector::vector; };
+
+constexpr std::size_t width = 8;
+
+Value build_recursive(std::size_t const depth, double& leaf)
 {
-#ifndef NDEBUG
-    std::println(
-        "\n"
-        "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n"
-        "   WARNING: This is NOT a Release build\n"
-        "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n"
-    );
-#endif
+    if (depth == 0) return leaf++;
 
-    std::random_device rd;
+    Array arr;
+    arr.reserve(width);
+    for (std::size_t i = 0; i < width; ++i) {
+        arr.emplace_back(build_recursive(depth - 1, leaf));
+    }
+    return Value(std::move(arr)); // moves the subtree into the parent
+}
 
-    // ----------------------------------------------------------
+template<class Builder, class ArrayT>
+void build_events(Builder& b, std::size_t const depth, double& leaf)
+{
+    if (depth == 0) {
+        b.value(leaf++);
+        return;
+    }
+    b.template begin<ArrayT>();
+    for (std::size_t i = 0; i < width; ++i) {
+        build_events<Builder, ArrayT>(b, depth - 1, leaf);
+    }
+    b.end();
+}
 
-    {
-        unsigned long long sum = 0;
+} // tree
+
+void benchmark_tree_builder(Report& report, std::size_t const N)
+{
+    std::size_t depth = 1;
+    for (std::size_t leaves = tree::width * tree::width; leaves <= N; leaves *= tree::width) ++depth;
+    report.N = N;
 
+    {
+        double leaf = 0;
         auto const start_time = Clock::now();
-        for (std::size_t i = 1; i < N; ++i) {
-            sum += N % i;
-        }
+        tree::Value v = tree::build_recursive(depth, leaf);
         auto const end_time = Clock::now();
         auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
-        std::println("Adding loop-based int {} times: {:.3f} ms", N, elapsed.count());
-
-        disable_optimization(sum);
+        report.entries.emplace_back("recursive construction + move", elapsed);
+        disable_optimization(v);
     }
     {
-        std::uniform_int_distribution<int> value_dist;
-        REng value_eng(rd());
+        double leaf = 0;
+        auto const start_time = Clock::now();
+        yk::tree_builder<tree::Value, tree::Array> b;
+        tree::build_events<decltype(b), tree::Array>(b, depth, leaf);
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        report.entries.emplace_back("tree_builder", elapsed);
+        disable_optimization(b.root());
+    }
+    {
+        std::pmr::monotonic_buffer_resource mr;
+        double leaf = 0;
+        auto const start_time = Clock::now();
+        yk::tree_builder<tree::PmrValue, tree::PmrArray> b(&mr);
+        tree::build_events<decltype(b), tree::PmrArray>(b, depth, leaf);
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        report.entries.emplace_back("tree_builder (pmr monotonic)", elapsed);
+        disable_optimization(b.root());
+    }
+}
 
-        unsigned long long sum = 0;
+void benchmark_lookup(Report& report, std::size_t const N)
+{
+    using V = yk::rvariant<int, std::string>;
+    report.N = N;
+
+    std::random_device rd;
+    std::uniform_int_distribution<int> value_dist;
+    REng value_eng(rd());
+
+    // long enough to defeat SSO, so that constructing the temporary key allocates
+    std::vector<std::string> keys;
+    keys.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        keys.emplace_back(std::format("{:064}", value_dist(value_eng)));
+    }
+
+    std::unordered_map<V, int, std::hash<V>> std_map;
+    std::unordered_map<V, int, yk::variant_hash<V>, yk::variant_equal_to<V>> transparent_map;
+    for (std::size_t i = 0; i < N; i += 2) {
+        std_map.emplace(keys[i], static_cast<int>(i));
+        transparent_map.emplace(keys[i], static_cast<int>(i));
+    }
+
+    std::vector<std::string_view> probes(keys.begin(), keys.end());
 
+    {
+        std::size_t found = 0;
         auto const start_time = Clock::now();
-        for (std::size_t i = 0; i < N; ++i) {
-            int const value = value_dist(value_eng);
-            sum += value;
+        for (auto const& probe : probes) {
+            found += std_map.find(V{std::string(probe)}) != std_map.end();
         }
         auto const end_time = Clock::now();
-        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
-        std::println("Adding random int {} times: {:.3f} ms", N, elapsed.count());
-
-        disable_optimization(sum);
+        report.entries.emplace_back("find (temporary rvariant)", std::chrono::duration_cast<duration_type>(end_time - start_time));
+        disable_optimization(found);
     }
-    std::println("");
+    {
+        std::size_t found = 0;
+        auto const start_time = Clock::now();
+        for (auto const& probe : probes) {
+            found += transparent_map.find(probe) != transparent_map.end();
+        }
+        auto const end_time = Clock::now();
+        report.entries.emplace_back("find (transparent std::string_view)", std::chrono::duration_cast<duration_type>(end_time - start_time));
+        disable_optimization(found);
+    }
+}
 
-    // ----------------------------------------------------------
+namespace hash_table {
 
-    Table
-        int_table_3{"int"}, int_table_16{"int"},
-        str_table_3{"std::string"}, str_table_16{"std::string"};
+// Minimal linear probing table with power-of-two capacity, as used by most
+// open addressing hash maps; sensitive to clustering in the low bits.
+template<class V, class Hash>
+struct linear_probing_set
+{
+    explicit linear_probing_set(std::size_t const capacity)
+        : slots(std::bit_ceil(capacity)), used(slots.size())
+    {}
 
-    do_bench<int>(int_table_3, int_table_16, N);
-    do_bench<std::string>(str_table_3, str_table_16, std::max(N / 5, 100uz));
+    // returns the probe length
+    std::size_t insert(V const& v)
+    {
+        std::size_t const mask = slots.size() - 1;
+        std::size_t pos = Hash{}(v) & mask;
+        std::size_t probes = 1;
+        while (used[pos]) {
+            if (slots[pos] == v) return probes;
+            pos = (pos + 1) & mask;
+            ++probes;
+        }
+        slots[pos] = v;
+        used[pos] = true;
+        return probes;
+    }
 
-    auto const save_csv = [](char const* name, std::string const& csv) {
-        std::println("{}", csv);
-        std::ofstream ofs(name);
-        ofs << csv;
-    };
-    save_csv("00_int3.csv", int_table_3.make_csv());
-    save_csv("01_int16.csv", int_table_16.make_csv());
-    save_csv("02_str3.csv", str_table_3.make_csv());
-    save_csv("03_str16.csv", str_table_16.make_csv());
+    std::vector<V> slots;
+    std::vector<bool> used;
+};
+
+template<class Hash, class V>
+void run(Report& report, std::string const& name, std::vector<V> const& keys)
+{
+    {
+        std::vector<std::size_t> hashes;
+        hashes.reserve(keys.size());
+        for (auto const& key : keys) hashes.push_back(Hash{}(key));
+        std::ranges::sort(hashes);
+        auto const collisions = static_cast<std::size_t>(std::ranges::distance(std::ranges::unique(hashes)));
+        std::println("{}: {} full hash collisions", name, collisions);
+    }
+    {
+        linear_probing_set<V, Hash> set(keys.size() * 2);
+        std::size_t total_probes = 0, max_probes = 0;
+
+        auto const start_time = Clock::now();
+        for (auto const& key : keys) {
+            std::size_t const probes = set.insert(key);
+            total_probes += probes;
+            max_probes = std::max(max_probes, probes);
+        }
+        auto const end_time = Clock::now();
+        std::println(
+            "{}: linear probing avg={:.2f} max={}", name,
+            static_cast<double>(total_probes) / static_cast<double>(keys.size()), max_probes
+        );
+        report.entries.emplace_back(name + " (linear probing)", std::chrono::duration_cast<duration_type>(end_time - start_time));
+        disable_optimization(set);
+    }
+    {
+        std::unordered_set<V, Hash> set;
+        set.reserve(keys.size());
+
+        auto const start_time = Clock::now();
+        for (auto const& key : keys) set.insert(key);
+        auto const end_time = Clock::now();
+        std::size_t max_bucket = 0;
+        for (std::size_t b = 0; b < set.bucket_count(); ++b) max_bucket = std::max(max_bucket, set.bucket_size(b));
+        std::println("{}: std::unordered_set max bucket={}", name, max_bucket);
+        report.entries.emplace_back(name + " (std::unordered_set)", std::chrono::duration_cast<duration_type>(end_time - start_time));
+        disable_optimization(set);
+    }
+}
+
+} // hash_table
+
+void benchmark_hash_quality(Report& report, std::size_t const N)
+{
+    using V = yk::rvariant<int, long long>;
+    report.N = N;
+
+    // sequential integers across alternatives
+    std::vector<V> keys;
+    keys.reserve(N * 2);
+    for (std::size_t i = 0; i < N; ++i) {
+        keys.emplace_back(std::in_place_index<0>, static_cast<int>(i));
+        keys.emplace_back(std::in_place_index<1>, static_cast<long long>(i));
+    }
+
+    hash_table::run<std::hash<V>>(report, "std::hash", keys);
+    hash_table::run<yk::rvariant_hasher<yk::avalanche_mixer>>(report, "rvariant_hasher<avalanche_mixer>", keys);
+    hash_table::run<yk::rvariant_hasher<yk::seeded_avalanche_mixer>>(report, "rvariant_hasher<seeded_avalanche_mixer>", keys);
+}
+
+void benchmark_equal(Report& report, std::size_t const N)
+{
+    using StdV = std::variant<int, unsigned>;
+    using V = yk::rvariant<int, unsigned>;
+    report.N = N;
+
+    std::random_device rd;
+    std::uniform_int_distribution<int> value_dist;
+    REng value_eng(rd());
+
+    std::vector<StdV> std_a, std_b;
+    std::vector<V> a, b;
+    std_a.reserve(N);
+    a.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int const value = value_dist(value_eng);
+        if (value % 2 == 0) {
+            std_a.emplace_back(std::in_place_index<0>, value);
+            a.emplace_back(std::in_place_index<0>, value);
+        } else {
+            std_a.emplace_back(std::in_place_index<1>, static_cast<unsigned>(value));
+            a.emplace_back(std::in_place_index<1>, static_cast<unsigned>(value));
+        }
+    }
+    std_b = std_a;
+    b = a;
+
+    constexpr int repeat = 10;
+    auto const run = [&](std::string key, auto const& f) {
+        bool result = true;
+        auto const start_time = Clock::now();
+        for (int r = 0; r < repeat; ++r) {
+            result &= f();
+            disable_optimization(result);
+        }
+        auto const end_time = Clock::now();
+        if (!result) throw std::logic_error{"unexpected inequality"};
+        report.entries.emplace_back(std::move(key), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    run("std::ranges::equal (std::variant)", [&] { return std::ranges::equal(std_a, std_b); });
+    run("std::ranges::equal (rvariant)", [&] { return std::ranges::equal(a, b); });
+    run("yk::equal (rvariant)", [&] { return yk::equal(a, b); });
+}
+
+namespace index_kernel {
+
+template<std::size_t Size>
+struct Padded
+{
+    unsigned char data[Size]{};
+};
+
+template<class V>
+void run(Report& report, std::size_t const N)
+{
+    std::random_device rd;
+    std::uniform_int_distribution<std::size_t> I_dist(0, 2);
+    REng I_eng(rd());
+
+    std::vector<V> vars;
+    vars.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        switch (I_dist(I_eng)) {
+        case 0: vars.emplace_back(std::in_place_index<0>); break;
+        case 1: vars.emplace_back(std::in_place_index<1>); break;
+        case 2: vars.emplace_back(std::in_place_index<2>); break;
+        default: std::unreachable();
+        }
+    }
+
+    auto const record = [&](std::string_view const name, auto const& f) {
+        auto const start_time = Clock::now();
+        auto const result = f();
+        auto const end_time = Clock::now();
+        disable_optimization(result);
+        report.entries.emplace_back(std::format("{} (sizeof={})", name, sizeof(V)), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    record("std::ranges::count_if", [&] { return std::ranges::count_if(vars, [](V const& v) { return v.index() == 1; }); });
+    record("count_index", [&] { return yk::count_index(vars, 1); });
+    record("index_histogram", [&] { return yk::index_histogram(vars); });
+    // not found; scans the entire range
+    record("find_index", [&] { return yk::find_index(vars, std::variant_npos) - vars.begin(); });
+    record("indices_of", [&] {
+        std::vector<std::size_t> positions;
+        positions.reserve(N);
+        yk::indices_of(vars, 1, std::back_inserter(positions));
+        return positions.size();
+    });
+}
+
+} // index_kernel
+
+void benchmark_index_kernel(Report& report, std::size_t const N)
+{
+    report.N = N;
+    index_kernel::run<yk::rvariant<int, float, index_kernel::Padded<3>>>(report, N);
+    index_kernel::run<yk::rvariant<int, double, index_kernel::Padded<12>>>(report, N);
+    index_kernel::run<yk::rvariant<int, double, index_kernel::Padded<24>>>(report, N);
+    index_kernel::run<yk::rvariant<int, double, index_kernel::Padded<56>>>(report, N);
+}
+
+namespace sort_by_index {
+
+template<class V>
+[[nodiscard]] std::vector<V> make_input(std::size_t const N)
+{
+    std::random_device rd;
+    std::uniform_int_distribution<int> value_dist;
+    REng value_eng(rd());
+
+    std::vector<V> vars;
+    vars.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int const value = value_dist(value_eng);
+        switch (value % 3) {
+        case 0: vars.emplace_back(std::in_place_index<0>, value); break;
+        case 1: vars.emplace_back(std::in_place_index<1>, make_value<yk::variant_alternative_t<1, V>>(value)); break;
+        case 2: vars.emplace_back(std::in_place_index<2>, static_cast<double>(value)); break;
+        default: std::unreachable();
+        }
+    }
+    return vars;
+}
+
+template<class V>
+void run(Report& report, std::string_view const type_name, std::size_t const N)
+{
+    auto const input = make_input<V>(N);
+
+    auto const record = [&](std::string_view const name, auto const& f) {
+        auto vars = input;
+        auto const start_time = Clock::now();
+        f(vars);
+        auto const end_time = Clock::now();
+        disable_optimization(vars);
+        report.entries.emplace_back(std::format("{} ({})", name, type_name), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    record("std::ranges::stable_sort", [](std::vector<V>& vars) {
+        std::ranges::stable_sort(vars, {}, [](V const& v) { return v.index(); });
+    });
+    record("counting_sort_by_index", [](std::vector<V>& vars) { disable_optimization(yk::counting_sort_by_index(vars)); });
+    record("partition_by_index", [](std::vector<V>& vars) { disable_optimization(yk::partition_by_index(vars)); });
+}
+
+} // sort_by_index
+
+void benchmark_sort_by_index(Report& report, std::size_t const N)
+{
+    report.N = N;
+    sort_by_index::run<yk::rvariant<int, int, double>>(report, "int / int / double", N);
+    sort_by_index::run<yk::rvariant<int, std::string, double>>(report, "int / std::string / double", N);
+}
+
+void benchmark_convert(Report& report, std::size_t const N)
+{
+    report.N = N;
+
+    std::random_device rd;
+    std::uniform_int_distribution<int> value_dist;
+    REng value_eng(rd());
+
+    auto const run = [&]<class From, class To>(std::string_view const type_name, std::type_identity<From>, std::type_identity<To>) {
+        std::vector<From> src;
+        src.reserve(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            int const value = value_dist(value_eng);
+            if (value % 2 == 0) {
+                src.emplace_back(std::in_place_index<0>, value);
+            } else {
+                src.emplace_back(std::in_place_index<1>, static_cast<double>(value));
+            }
+        }
+        {
+            std::vector<To> dst(N);
+            auto const start_time = Clock::now();
+            for (std::size_t i = 0; i < N; ++i) {
+                dst[i] = To(src[i]);
+            }
+            auto const end_time = Clock::now();
+            disable_optimization(dst);
+            report.entries.emplace_back(std::format("converting constructor ({})", type_name), std::chrono::duration_cast<duration_type>(end_time - start_time));
+        }
+        {
+            std::vector<To> dst(N);
+            auto const start_time = Clock::now();
+            yk::convert_range<To>(src, dst.begin());
+            auto const end_time = Clock::now();
+            disable_optimization(dst);
+            report.entries.emplace_back(std::format("convert_range ({})", type_name), std::chrono::duration_cast<duration_type>(end_time - start_time));
+        }
+    };
+
+    run(
+        "rvariant<int, double> -> rvariant<float, int, long long, double>",
+        std::type_identity<yk::rvariant<int, double>>{}, std::type_identity<yk::rvariant<float, int, long long, double>>{}
+    );
+}
+
+namespace mailbox_bench {
+
+using Message = yk::rvariant<int, double, std::string>;
+
+// mutex-protected queue, for comparison
+class locked_queue
+{
+public:
+    bool try_push(Message&& msg)
+    {
+        std::lock_guard lock(mtx_);
+        queue_.push_back(std::move(msg));
+        return true;
+    }
+
+    template<class Visitor>
+    std::size_t drain(Visitor&& vis)
+    {
+        std::deque<Message> taken;
+        {
+            std::lock_guard lock(mtx_);
+            taken.swap(queue_);
+        }
+        for (auto const& msg : taken) yk::visit(vis, msg);
+        return taken.size();
+    }
+
+private:
+    std::mutex mtx_;
+    std::deque<Message> queue_;
+};
+
+template<class Queue, class Push>
+duration_type run(Queue& queue, Push push, std::size_t const producers, std::size_t const N)
+{
+    std::size_t const per_producer = N / producers;
+    std::atomic<bool> go{false};
+    std::vector<std::jthread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (std::size_t i = 0; i < per_producer; ++i) {
+                while (!push(queue, p, i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::size_t sum = 0;
+    auto const vis = yk::overloaded{
+        [&](int x) { sum += static_cast<std::size_t>(x); },
+        [&](double x) { sum += static_cast<std::size_t>(x); },
+        [&](std::string const& x) { sum += x.size(); },
+    };
+
+    auto const start_time = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::size_t consumed = 0; consumed < per_producer * producers;) {
+        consumed += queue.drain(vis);
+    }
+    auto const end_time = Clock::now();
+    disable_optimization(sum);
+    return std::chrono::duration_cast<duration_type>(end_time - start_time);
+}
+
+} // mailbox_bench
+
+void benchmark_mailbox(Report& report, std::size_t const N)
+{
+    using namespace mailbox_bench;
+    report.N = N;
+
+    auto const make = [](std::size_t const p, std::size_t const i) -> Message {
+        switch ((p + i) % 3) {
+        case 0: return Message{std::in_place_index<0>, static_cast<int>(i)};
+        case 1: return Message{std::in_place_index<1>, static_cast<double>(i)};
+        default: return Message{std::in_place_index<2>, "message"};
+        }
+    };
+
+    for (std::size_t const producers : {1uz, 2uz, 4uz, 8uz, 16uz}) {
+        {
+            yk::mailbox<Message> mb(4096);
+            auto const d = run(mb, [&](auto& q, std::size_t p, std::size_t i) {
+                switch ((p + i) % 3) {
+                case 0: return q.template try_emplace<0>(static_cast<int>(i));
+                case 1: return q.template try_emplace<1>(static_cast<double>(i));
+                default: return q.template try_emplace<2>("message");
+                }
+            }, producers, N);
+            report.entries.emplace_back(std::format("yk::mailbox (producers={})", producers), d);
+        }
+        {
+            locked_queue queue;
+            auto const d = run(queue, [&](auto& q, std::size_t p, std::size_t i) {
+                return q.try_push(make(p, i));
+            }, producers, N);
+            report.entries.emplace_back(std::format("std::mutex + std::deque (producers={})", producers), d);
+        }
+    }
+
+    // mean enqueue-to-visit latency, single producer
+    {
+        using Stamped = yk::rvariant<Clock::time_point, int>;
+        yk::mailbox<Stamped> mb(4096);
+        std::atomic<bool> go{false};
+        std::jthread producer([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (std::size_t i = 0; i < N; ++i) {
+                while (!mb.try_emplace<0>(Clock::now())) std::this_thread::yield();
+            }
+        });
+        Clock::duration total{};
+        go.store(true, std::memory_order_release);
+        for (std::size_t consumed = 0; consumed < N;) {
+            consumed += mb.drain(yk::overloaded{
+                [&](Clock::time_point const& t) { total += Clock::now() - t; },
+                [](int) {},
+            });
+        }
+        report.entries.emplace_back("yk::mailbox latency (mean, producers=1)", std::chrono::duration_cast<duration_type>(total / static_cast<Clock::rep>(N)));
+    }
+}
+
+namespace seqlock_bench {
+
+struct Quote { double bid, ask; std::int64_t bid_size, ask_size, time, venue, flags, seq; };
+struct Trade { double price; std::int64_t size, time, venue, flags, seq, buyer, seller, id, reserved[3]; };
+struct Halt { std::int64_t time, reason; };
+
+using State = yk::rvariant<Quote, Trade, Halt>;
+
+class locked_state
+{
+public:
+    void store(State const& v)
+    {
+        std::unique_lock lock(mtx_);
+        state_ = v;
+    }
+
+    template<class Visitor>
+    decltype(auto) visit(Visitor&& vis) const
+    {
+        std::shared_lock lock(mtx_);
+        return yk::visit(std::forward<Visitor>(vis), state_);
+    }
+
+private:
+    mutable std::shared_mutex mtx_;
+    State state_{Halt{}};
+};
+
+// Time for every reader to complete `N` reads while one writer keeps publishing
+template<class Shared>
+duration_type run(Shared& shared, std::size_t const readers, std::size_t const N)
+{
+    std::atomic<bool> go{false}, done{false};
+    std::jthread writer([&] {
+        while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+        for (std::int64_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+            if (i % 2 == 0) {
+                shared.store(State{std::in_place_index<0>, Quote{1.0, 2.0, i, i, i, i, i, i}});
+            } else {
+                shared.store(State{std::in_place_index<1>, Trade{1.5, i, i, i, i, i, i, i, i, {}}});
+            }
+        }
+    });
+
+    std::vector<std::jthread> threads;
+    for (std::size_t r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::int64_t sum = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                sum += shared.visit(yk::overloaded{
+                    [](Quote const& q) { return q.seq; },
+                    [](Trade const& t) { return t.seq; },
+                    [](Halt const& h) { return h.time; },
+                });
+            }
+            disable_optimization(sum);
+        });
+    }
+
+    auto const start_time = Clock::now();
+    go.store(true, std::memory_order_release);
+    threads.clear();
+    auto const end_time = Clock::now();
+    done.store(true, std::memory_order_relaxed);
+    return std::chrono::duration_cast<duration_type>(end_time - start_time);
+}
+
+} // seqlock_bench
+
+void benchmark_seqlock(Report& report, std::size_t const N)
+{
+    using namespace seqlock_bench;
+    report.N = N;
+
+    for (std::size_t const readers : {1uz, 2uz, 4uz, 8uz, 16uz, 32uz}) {
+        {
+            yk::shared_rvariant<State> shared(std::in_place_index<2>, Halt{});
+            report.entries.emplace_back(std::format("yk::shared_rvariant (readers={})", readers), run(shared, readers, N));
+        }
+        {
+            locked_state shared;
+            report.entries.emplace_back(std::format("std::shared_mutex (readers={})", readers), run(shared, readers, N));
+        }
+    }
+}
+
+void benchmark_parallel_tree(Report& report, std::size_t const N)
+{
+    std::size_t depth = 1;
+    for (std::size_t leaves = tree::width * tree::width; leaves <= N; leaves *= tree::width) ++depth;
+    report.N = N;
+
+    double leaf = 0;
+    tree::Value const source = tree::build_recursive(depth, leaf);
+
+    {
+        auto const start_time = Clock::now();
+        tree::Value copy = source;
+        auto const end_time = Clock::now();
+        report.entries.emplace_back("copy constructor", std::chrono::duration_cast<duration_type>(end_time - start_time));
+        disable_optimization(copy);
+    }
+    {
+        auto copy = std::make_unique<tree::Value>(source);
+        auto const start_time = Clock::now();
+        copy.reset();
+        auto const end_time = Clock::now();
+        report.entries.emplace_back("destructor", std::chrono::duration_cast<duration_type>(end_time - start_time));
+    }
+
+    for (std::size_t const threads : {1uz, 2uz, 4uz, 8uz, 16uz, 32uz}) {
+        auto const start_time = Clock::now();
+        tree::Value copy = yk::parallel_deep_copy(source, threads);
+        auto const mid_time = Clock::now();
+        disable_optimization(copy);
+        yk::parallel_destroy(std::move(copy), threads);
+        auto const end_time = Clock::now();
+        report.entries.emplace_back(std::format("parallel_deep_copy (threads={})", threads), std::chrono::duration_cast<duration_type>(mid_time - start_time));
+        report.entries.emplace_back(std::format("parallel_destroy (threads={})", threads), std::chrono::duration_cast<duration_type>(end_time - mid_time));
+    }
+}
+
+namespace parallel_visit {
+
+struct Cheap { std::uint32_t value; };
+struct Expensive { double value; };
+
+using V = yk::rvariant<Cheap, Expensive>;
+
+constexpr double expensive_cost = 64;
+
+struct work
+{
+    void operator()(Cheap& x) const noexcept
+    {
+        x.value = x.value * 2654435761u + 1;
+    }
+
+    void operator()(Expensive& x) const noexcept
+    {
+        double v = x.value;
+        for (int i = 0; i < static_cast<int>(expensive_cost); ++i) {
+            v = v * 0.999 + 1.0 / (v + 1.0);
+        }
+        x.value = v;
+    }
+};
+
+} // parallel_visit
+
+void benchmark_parallel_visit(Report& report, std::size_t const N)
+{
+    using namespace parallel_visit;
+    report.N = N;
+
+    // The expensive elements are clustered at the front (10% of the range),
+    // which defeats the chunking by element count.
+    std::vector<V> vars;
+    vars.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i < N / 10 && i % 2 == 0) {
+            vars.emplace_back(std::in_place_index<1>, static_cast<double>(i));
+        } else {
+            vars.emplace_back(std::in_place_index<0>, static_cast<std::uint32_t>(i));
+        }
+    }
+    yk::visit_cost_table<V> const costs{1.0, expensive_cost};
+
+    auto const measure = [&](std::string const& name, auto const& f) {
+        auto const start_time = Clock::now();
+        f();
+        auto const end_time = Clock::now();
+        disable_optimization(vars);
+        report.entries.emplace_back(name, std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+#if YK_RVARIANT_HAS_EXECUTION_POLICY
+    measure("std::for_each(par_unseq) + yk::visit", [&] {
+        std::for_each(std::execution::par_unseq, vars.begin(), vars.end(), [](V& v) { yk::visit(work{}, v); });
+    });
+    measure("visit_each(par, costs)", [&] {
+        yk::visit_each(std::execution::par, vars, work{}, costs);
+    });
+#endif
+
+    for (std::size_t const threads : {1uz, 2uz, 4uz, 8uz, 16uz, 32uz, 64uz}) {
+        measure(std::format("visit_each (threads={})", threads), [&] {
+            yk::visit_each(yk::jthread_policy{threads}, vars, work{});
+        });
+        measure(std::format("visit_each, costs (threads={})", threads), [&] {
+            yk::visit_each(yk::jthread_policy{threads}, vars, work{}, costs);
+        });
+        measure(std::format("visit_each, group_by_index, costs (threads={})", threads), [&] {
+            yk::visit_each(yk::jthread_policy{threads}, yk::group_by_index, vars, work{}, costs);
+        });
+    }
+}
+
+namespace nothrow_move {
+
+template<bool OptIn>
+void run(Report& report, std::size_t const N)
+{
+    using Var = V<OptIn>;
+    static_assert(yk::detail::is_never_valueless_v<int, std::string, std::vector<int>, tag<OptIn>> == OptIn);
+    constexpr std::string_view mode = OptIn ? "nothrow_move_never_valueless" : "default";
+
+    std::random_device rd;
+    std::uniform_int_distribution<int> value_dist(0, 1 << 16);
+    REng value_eng(rd());
+
+    std::vector<Var> vars;
+    vars.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int const value = value_dist(value_eng);
+        switch (value % 3) {
+        case 0: vars.emplace_back(std::in_place_index<0>, value); break;
+        case 1: vars.emplace_back(std::in_place_index<1>, std::to_string(value)); break;
+        case 2: vars.emplace_back(std::in_place_index<2>, static_cast<std::size_t>(value % 8), value); break;
+        default: std::unreachable();
+        }
+    }
+
+    {
+        auto const vis = yk::overloaded{
+            [](int x) { return static_cast<std::size_t>(x); },
+            [](std::string const& x) { return x.size(); },
+            [](std::vector<int> const& x) { return x.size(); },
+            [](tag<OptIn>) { return 0uz; },
+        };
+        std::size_t sum = 0;
+        auto const start_time = Clock::now();
+        for (int r = 0; r < 10; ++r) {
+            for (auto const& v : vars) sum += yk::visit(vis, v);
+        }
+        auto const end_time = Clock::now();
+        disable_optimization(sum);
+        report.entries.emplace_back(std::format("visit ({})", mode), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    }
+    {
+        // potentially-throwing constructors; takes the construct-then-move path if opted in
+        auto const start_time = Clock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            if (i % 2 == 0) {
+                vars[i].template emplace<1>(8uz, 'x');
+            } else {
+                vars[i].template emplace<2>(8uz, 42);
+            }
+        }
+        auto const end_time = Clock::now();
+        disable_optimization(vars);
+        report.entries.emplace_back(std::format("emplace ({})", mode), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    }
+}
+
+} // nothrow_move
+
+void benchmark_nothrow_move(Report& report, std::size_t const N)
+{
+    report.N = N;
+    nothrow_move::run<false>(report, N);
+    nothrow_move::run<true>(report, N);
+}
+
+void benchmark_assign_or_emplace(Report& report, std::size_t const N)
+{
+    using V = yk::rvariant<std::int64_t, std::string, double>;
+    report.N = N;
+
+    // 80% of the messages are strings long enough to defeat SSO
+    std::random_device rd;
+    std::uniform_int_distribution<int> value_dist(0, 99);
+    REng value_eng(rd());
+
+    std::vector<std::string> messages;
+    messages.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        int const value = value_dist(value_eng);
+        if (value < 80) {
+            messages.emplace_back("#" + std::string(24 + static_cast<std::size_t>(value % 48), static_cast<char>('a' + value % 26)));
+        } else {
+            messages.emplace_back(std::to_string(value));
+        }
+    }
+
+    auto const parse_int = [](std::string_view const msg) {
+        std::int64_t x = 0;
+        std::from_chars(msg.data(), msg.data() + msg.size(), x);
+        return x;
+    };
+
+    // one variant reused for every message, as in a per-thread decode loop
+    auto const run = [&](std::string_view const name, auto const& decode) {
+        V v;
+        std::size_t sum = 0;
+        auto const start_time = Clock::now();
+        for (auto const& msg : messages) {
+            decode(v, std::string_view{msg});
+            sum += v.index();
+        }
+        auto const end_time = Clock::now();
+        disable_optimization(sum);
+        report.entries.emplace_back(std::string(name), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    run("emplace", [&](V& v, std::string_view const msg) {
+        if (msg.front() == '#') {
+            v.emplace<1>(msg.substr(1));
+        } else {
+            v.emplace<0>(parse_int(msg));
+        }
+    });
+    run("assign_or_emplace", [&](V& v, std::string_view const msg) {
+        if (msg.front() == '#') {
+            v.assign_or_emplace<1>(msg.substr(1));
+        } else {
+            v.assign_or_emplace<0>(parse_int(msg));
+        }
+    });
+}
+
+void benchmark_for_overwrite(Report& report, std::size_t const N)
+{
+    struct Packet
+    {
+        std::byte payload[60];
+    };
+    using V = yk::rvariant<Packet, int>;
+    report.N = N;
+
+    // resize, then overwrite every element, as in a bulk decode into a preallocated buffer
+    auto const run = [&]<class Alloc>(std::string_view const name, std::type_identity<Alloc>) {
+        std::size_t sum = 0;
+        auto const start_time = Clock::now();
+        for (int repeat = 0; repeat < 8; ++repeat) {
+            std::vector<V, Alloc> vars;
+            vars.resize(N);
+            for (std::size_t i = 0; i < N; ++i) {
+                if (i % 4 == 0) {
+                    vars[i].template emplace<1>(static_cast<int>(i));
+                } else {
+                    auto& packet = vars[i].template emplace<0>();
+                    packet.payload[0] = static_cast<std::byte>(i);
+                }
+            }
+            for (auto const& v : vars) sum += v.index();
+        }
+        auto const end_time = Clock::now();
+        disable_optimization(sum);
+        report.entries.emplace_back(std::string(name), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    run("std::allocator", std::type_identity<std::allocator<V>>{});
+    run("default_init_allocator", std::type_identity<yk::default_init_allocator<V>>{});
+}
+
+namespace visit_same_bench {
+
+template<std::size_t I>
+struct alt
+{
+    int value;
+};
+
+template<std::size_t... Is>
+yk::rvariant<alt<Is>...> make_variant(std::index_sequence<Is...>);
+
+template<std::size_t AltN>
+using V = decltype(make_variant(std::make_index_sequence<AltN>{}));
+
+template<class Variant, std::size_t... Is>
+[[nodiscard]] Variant make_at(std::size_t const i, int const value, std::index_sequence<Is...>)
+{
+    using make_fn = Variant(*)(int);
+    static constexpr make_fn table[] = {
+        +[](int const v) { return Variant{std::in_place_index<Is>, v}; }...
+    };
+    return table[i](value);
+}
+
+// Only the pairs of the same alternative do meaningful work
+struct same_only
+{
+    template<std::size_t I, std::size_t J>
+    int operator()(alt<I> const& a, alt<J> const& b) const noexcept
+    {
+        if constexpr (I == J) {
+            return a.value + b.value * static_cast<int>(I + 1);
+        } else {
+            return -1;
+        }
+    }
+};
+
+template<std::size_t AltN>
+void run(Report& report, std::size_t const N)
+{
+    using Variant = V<AltN>;
+
+    std::random_device rd;
+    std::uniform_int_distribution<std::size_t> I_dist(0, AltN - 1);
+    std::uniform_int_distribution<int> mismatch_dist(0, 15);
+    REng eng(rd());
+
+    // 1 in 16 pairs mismatches
+    std::vector<Variant> lhs, rhs;
+    lhs.reserve(N);
+    rhs.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t const a = I_dist(eng);
+        std::size_t const b = mismatch_dist(eng) == 0 ? (a + 1) % AltN : a;
+        lhs.emplace_back(make_at<Variant>(a, static_cast<int>(i), std::make_index_sequence<AltN>{}));
+        rhs.emplace_back(make_at<Variant>(b, static_cast<int>(i), std::make_index_sequence<AltN>{}));
+    }
+
+    auto const record = [&](std::string_view const name, auto const& f) {
+        long long sum = 0;
+        auto const start_time = Clock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            sum += f(lhs[i], rhs[i]);
+        }
+        auto const end_time = Clock::now();
+        disable_optimization(sum);
+        report.entries.emplace_back(std::format("{} (alternatives={})", name, AltN), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    record("yk::visit", [](Variant const& a, Variant const& b) {
+        return yk::visit(same_only{}, a, b);
+    });
+    record("yk::visit_same", [](Variant const& a, Variant const& b) {
+        return yk::visit_same(same_only{}, [](Variant const&, Variant const&) noexcept { return -1; }, a, b);
+    });
+}
+
+} // visit_same_bench
+
+void benchmark_visit_same(Report& report, std::size_t const N)
+{
+    report.N = N;
+    visit_same_bench::run<16>(report, N);
+    visit_same_bench::run<64>(report, N);
+}
+
+void benchmark_visit_some(Report& report, std::size_t const N)
+{
+    using visit_same_bench::alt;
+    using Variant = visit_same_bench::V<40>;
+    report.N = N;
+
+    std::random_device rd;
+    std::uniform_int_distribution<std::size_t> I_dist(0, 39);
+    REng eng(rd());
+
+    std::vector<Variant> vars;
+    vars.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        vars.emplace_back(visit_same_bench::make_at<Variant>(I_dist(eng), static_cast<int>(i), std::make_index_sequence<40>{}));
+    }
+
+    // 3 of 40 alternatives are interesting; the rest share one handler
+    constexpr auto on_selected = yk::overloaded{
+        [](alt<2> const& x) noexcept { return x.value * 3; },
+        [](alt<17> const& x) noexcept { return x.value ^ 0x55; },
+        [](alt<33> const& x) noexcept { return -x.value; },
+    };
+    constexpr auto on_other = [](Variant const& v) noexcept { return static_cast<int>(v.index()); };
+
+    auto const record = [&](std::string_view const name, auto const& f) {
+        long long sum = 0;
+        auto const start_time = Clock::now();
+        for (auto const& v : vars) {
+            sum += f(v);
+        }
+        auto const end_time = Clock::now();
+        disable_optimization(sum);
+        report.entries.emplace_back(std::string(name), std::chrono::duration_cast<duration_type>(end_time - start_time));
+    };
+
+    record("yk::visit", [&](Variant const& v) {
+        return yk::visit(yk::overloaded{
+            on_selected,
+            [&]<std::size_t I>(alt<I> const&) noexcept { return on_other(v); },
+        }, v);
+    });
+    record("yk::visit_some", [&](Variant const& v) {
+        return yk::visit_some<2, 17, 33>(v, on_selected, on_other);
+    });
+}
+
+template<class T>
+void do_bench(Table& table_3, Table& table_16, std::size_t const N)
+{
+    table_3.N = N;
+    table_16.N = N;
+
+    {
+        constexpr std::size_t AltN = 3;
+        table_3.AltN = AltN;
+
+        {
+            using V = many_V_t<std::variant, AltN, T>;
+            auto& entries = table_3.std_datas;
+
+            std::vector<V, yk::default_init_allocator<V>> vars;
+            benchmark_construct_3<T>(entries, N, vars);
+            benchmark_copy_assign(entries, N, vars);
+
+            benchmark_get_3(entries, N, vars);
+            benchmark_get_if_3(entries, N, vars);
+            benchmark_visit(entries, N, vars);
+            benchmark_multi_visit(entries, N, vars);
+
+            benchmark_operator<std::equal_to<>>(entries, N, vars);
+            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
+            benchmark_operator<std::less<>>(entries, N, vars);
+            benchmark_operator<std::greater<>>(entries, N, vars);
+            benchmark_operator<std::less_equal<>>(entries, N, vars);
+            benchmark_operator<std::greater_equal<>>(entries, N, vars);
+            benchmark_operator<std::compare_three_way>(entries, N, vars);
+        }
+        {
+            using V = many_V_t<yk::rvariant, AltN, T>;
+            auto& entries = table_3.rva_datas;
+
+            std::vector<V, yk::default_init_allocator<V>> vars;
+            benchmark_construct_3<T>(entries, N, vars);
+            benchmark_copy_assign(entries, N, vars);
+
+            benchmark_get_3(entries, N, vars);
+            benchmark_get_if_3(entries, N, vars);
+            benchmark_visit(entries, N, vars);
+            benchmark_multi_visit(entries, N, vars);
+
+            benchmark_operator<std::equal_to<>>(entries, N, vars);
+            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
+            benchmark_operator<std::less<>>(entries, N, vars);
+            benchmark_operator<std::greater<>>(entries, N, vars);
+            benchmark_operator<std::less_equal<>>(entries, N, vars);
+            benchmark_operator<std::greater_equal<>>(entries, N, vars);
+            benchmark_operator<std::compare_three_way>(entries, N, vars);
+        }
+    }
+    {
+        constexpr std::size_t AltN = 16;
+        table_16.AltN = 16;
+
+        {
+            using V = many_V_t<std::variant, AltN, T>;
+            auto& entries = table_16.std_datas;
+
+            std::vector<V, yk::default_init_allocator<V>> vars;
+            benchmark_construct_16<T>(entries, N, vars);
+            benchmark_copy_assign(entries, N, vars);
+
+            benchmark_get_16(entries, N, vars);
+            benchmark_get_if_16(entries, N, vars);
+            benchmark_visit(entries, N, vars);
+            benchmark_multi_visit(entries, N, vars);
+
+            benchmark_operator<std::equal_to<>>(entries, N, vars);
+            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
+            benchmark_operator<std::less<>>(entries, N, vars);
+            benchmark_operator<std::greater<>>(entries, N, vars);
+            benchmark_operator<std::less_equal<>>(entries, N, vars);
+            benchmark_operator<std::greater_equal<>>(entries, N, vars);
+            benchmark_operator<std::compare_three_way>(entries, N, vars);
+        }
+        {
+            using V = many_V_t<yk::rvariant, AltN, T>;
+            auto& entries = table_16.rva_datas;
+
+            std::vector<V, yk::default_init_allocator<V>> vars;
+            benchmark_construct_16<T>(entries, N, vars);
+            benchmark_copy_assign(entries, N, vars);
+
+            benchmark_get_16(entries, N, vars);
+            benchmark_get_if_16(entries, N, vars);
+            benchmark_visit(entries, N, vars);
+            benchmark_multi_visit(entries, N, vars);
+
+            benchmark_operator<std::equal_to<>>(entries, N, vars);
+            benchmark_operator<std::not_equal_to<>>(entries, N, vars);
+            benchmark_operator<std::less<>>(entries, N, vars);
+            benchmark_operator<std::greater<>>(entries, N, vars);
+            benchmark_operator<std::less_equal<>>(entries, N, vars);
+            benchmark_operator<std::greater_equal<>>(entries, N, vars);
+            benchmark_operator<std::compare_three_way>(entries, N, vars);
+        }
+    }
+}
+
+int benchmark_main(std::size_t const N)
+{
+#ifndef NDEBUG
+    std::println(
+        "\n"
+        "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n"
+        "   WARNING: This is NOT a Release build\n"
+        "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n"
+    );
+#endif
+
+    std::random_device rd;
+
+    // ----------------------------------------------------------
+
+    {
+        unsigned long long sum = 0;
+
+        auto const start_time = Clock::now();
+        for (std::size_t i = 1; i < N; ++i) {
+            sum += N % i;
+        }
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        std::println("Adding loop-based int {} times: {:.3f} ms", N, elapsed.count());
+
+        disable_optimization(sum);
+    }
+    {
+        std::uniform_int_distribution<int> value_dist;
+        REng value_eng(rd());
+
+        unsigned long long sum = 0;
+
+        auto const start_time = Clock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            int const value = value_dist(value_eng);
+            sum += value;
+        }
+        auto const end_time = Clock::now();
+        auto const elapsed = std::chrono::duration_cast<duration_type>(end_time - start_time);
+        std::println("Adding random int {} times: {:.3f} ms", N, elapsed.count());
+
+        disable_optimization(sum);
+    }
+    std::println("");
+
+    // ----------------------------------------------------------
+
+    Table
+        int_table_3{"int"}, int_table_16{"int"},
+        str_table_3{"std::string"}, str_table_16{"std::string"};
+
+    do_bench<int>(int_table_3, int_table_16, N);
+    do_bench<std::string>(str_table_3, str_table_16, std::max(N / 5, 100uz));
+
+    auto const save_csv = [](char const* name, std::string const& csv) {
+        std::println("{}", csv);
+        std::ofstream ofs(name);
+        ofs << csv;
+    };
+    save_csv("00_int3.csv", int_table_3.make_csv());
+    save_csv("01_int16.csv", int_table_16.make_csv());
+    save_csv("02_str3.csv", str_table_3.make_csv());
+    save_csv("03_str16.csv", str_table_16.make_csv());
+
+    // ----------------------------------------------------------
+
+    Report format_report{"format (int / double / std::string)"};
+    benchmark_format(format_report, std::max(N / 10, 100uz));
+    save_csv("04_format.csv", format_report.make_csv());
+
+    Report parse_report{"parse (std::monostate / std::int64_t / double / bool / std::string_view)"};
+    benchmark_parse(parse_report, N);
+    save_csv("05_parse.csv", parse_report.make_csv());
+
+    Report tree_report{"tree (width=8)"};
+    benchmark_tree_builder(tree_report, N);
+    save_csv("06_tree.csv", tree_report.make_csv());
+
+    Report lookup_report{"lookup (int / std::string)"};
+    benchmark_lookup(lookup_report, std::max(N / 10, 100uz));
+    save_csv("07_lookup.csv", lookup_report.make_csv());
+
+    Report hash_report{"hash quality (sequential int / long long)"};
+    benchmark_hash_quality(hash_report, std::max(N / 10, 100uz));
+    save_csv("08_hash.csv", hash_report.make_csv());
+
+    Report equal_report{"equal (int / unsigned)"};
+    benchmark_equal(equal_report, N);
+    save_csv("09_equal.csv", equal_report.make_csv());
+
+    Report index_report{"index kernels (alternatives=3)"};
+    benchmark_index_kernel(index_report, N);
+    save_csv("10_index.csv", index_report.make_csv());
+
+    Report sort_report{"sort by index (alternatives=3)"};
+    benchmark_sort_by_index(sort_report, std::max(N / 5, 100uz));
+    save_csv("11_sort.csv", sort_report.make_csv());
+
+    Report convert_report{"convert"};
+    benchmark_convert(convert_report, N);
+    save_csv("12_convert.csv", convert_report.make_csv());
+
+    Report mailbox_report{"mailbox (int / double / std::string)"};
+    benchmark_mailbox(mailbox_report, std::max(N / 10, 1000uz));
+    save_csv("13_mailbox.csv", mailbox_report.make_csv());
+
+    Report seqlock_report{"seqlock (1 writer, Quote / Trade / Halt)"};
+    benchmark_seqlock(seqlock_report, std::max(N / 10, 1000uz));
+    save_csv("14_seqlock.csv", seqlock_report.make_csv());
+
+    Report parallel_tree_report{"parallel tree copy / destroy (width=8)"};
+    benchmark_parallel_tree(parallel_tree_report, N);
+    save_csv("15_parallel_tree.csv", parallel_tree_report.make_csv());
+
+    Report parallel_visit_report{"parallel visit (cheap / expensive)"};
+    benchmark_parallel_visit(parallel_visit_report, N);
+    save_csv("16_parallel_visit.csv", parallel_visit_report.make_csv());
+
+    Report nothrow_move_report{"never valueless by nothrow move (int / std::string / std::vector<int>)"};
+    benchmark_nothrow_move(nothrow_move_report, N);
+    save_csv("17_nothrow_move.csv", nothrow_move_report.make_csv());
+
+    Report assign_or_emplace_report{"decode loop (std::int64_t / std::string / double)"};
+    benchmark_assign_or_emplace(assign_or_emplace_report, N);
+    save_csv("18_assign_or_emplace.csv", assign_or_emplace_report.make_csv());
+
+    Report for_overwrite_report{"resize and fill (Packet{std::byte[60]} / int)"};
+    benchmark_for_overwrite(for_overwrite_report, N);
+    save_csv("19_for_overwrite.csv", for_overwrite_report.make_csv());
+
+    Report visit_same_report{"binary visit on the same alternative (1/16 mismatch)"};
+    benchmark_visit_same(visit_same_report, N);
+    save_csv("20_visit_same.csv", visit_same_report.make_csv());
+
+    Report visit_some_report{"partial visit (3 of 40 alternatives)"};
+    benchmark_visit_some(visit_some_report, N);
+    save_csv("21_visit_some.csv", visit_some_report.make_csv());
 
     return EXIT_SUCCESS;
 }
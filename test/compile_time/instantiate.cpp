@@ -0,0 +1,15 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// The single translation unit providing the definitions for the `extern_template` case.
+
+#include <yk/rvariant.hpp>
+#include <yk/rvariant/explicit_instantiation.hpp>
+
+#include <string>
+
+#include "workload_types.hpp"
+
+YK_RVARIANT_INSTANTIATE(int, double, std::string, long long, char);
+YK_RVARIANT_INSTANTIATE(int, yk::recursive_wrapper<yk_ct::Binary>);
@@ -0,0 +1,96 @@
+# Copyright 2025 Nana Sakisaka
+# Distributed under the Boost Software License, Version 1.0.
+# https://www.boost.org/LICENSE_1_0.txt
+
+# Runs the compile-time benchmark; see test/compile_time/CMakeLists.txt.
+#
+#   cmake -DBUILD_DIR=<build dir> [-DCONFIG=Release] [-DJOBS=1] -P test/compile_time/run.cmake
+
+cmake_minimum_required(VERSION 3.23) # string(TIMESTAMP) with %f
+
+if(NOT DEFINED BUILD_DIR)
+    message(FATAL_ERROR "usage: cmake -DBUILD_DIR=<build dir> [-DCONFIG=Release] [-DJOBS=1] -P run.cmake")
+endif()
+if(NOT DEFINED CONFIG)
+    set(CONFIG Release)
+endif()
+if(NOT DEFINED JOBS)
+    set(JOBS 1) # serial by default, so that the result approximates the total CPU time
+endif()
+
+set(cases_file "${BUILD_DIR}/test/compile_time/cases.cmake")
+if(NOT EXISTS ${cases_file})
+    message(FATAL_ERROR "${cases_file} not found; configure with -DYK_RVARIANT_COMPILE_TIME_BENCHMARK=ON")
+endif()
+include(${cases_file})
+
+function(yk_ct_now_ms out)
+    string(TIMESTAMP now "%s%f" UTC) # microseconds since epoch
+    math(EXPR now "${now} / 1000")
+    set(${out} ${now} PARENT_SCOPE)
+endfunction()
+
+function(yk_ct_build target out)
+    yk_ct_now_ms(start)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} --build ${BUILD_DIR} --config ${CONFIG} --target ${target} --parallel ${JOBS}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    yk_ct_now_ms(end)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "failed to build ${target}")
+    endif()
+    math(EXPR elapsed "${end} - ${start}")
+    set(${out} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+# Sum of the sizes of the object files of the case
+function(yk_ct_object_size case out)
+    file(GLOB_RECURSE objects
+        "${BUILD_DIR}/test/compile_time/CMakeFiles/yk_rvariant_ct_${case}.dir/*.o"
+        "${BUILD_DIR}/test/compile_time/CMakeFiles/yk_rvariant_ct_${case}.dir/*.obj"
+    )
+    set(total 0)
+    foreach(object IN LISTS objects)
+        file(SIZE ${object} size)
+        math(EXPR total "${total} + ${size}")
+    endforeach()
+    set(${out} ${total} PARENT_SCOPE)
+endfunction()
+
+function(yk_ct_clean)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} --build ${BUILD_DIR} --config ${CONFIG} --target clean
+        OUTPUT_QUIET
+    )
+endfunction()
+
+set(csv "compile time | TU=${YK_CT_TU_COUNT} JOBS=${JOBS},ms\n")
+set(size_csv "object size | TU=${YK_CT_TU_COUNT},bytes\n")
+
+foreach(case IN LISTS YK_CT_CASES)
+    yk_ct_clean()
+
+    set(prerequisite_ms 0)
+    if(DEFINED YK_CT_PREREQUISITE_${case})
+        yk_ct_build(${YK_CT_PREREQUISITE_${case}} prerequisite_ms)
+        string(APPEND csv "${case} (${YK_CT_PREREQUISITE_${case}} only),${prerequisite_ms}\n")
+    endif()
+
+    yk_ct_build(yk_rvariant_ct_${case} case_ms)
+    string(APPEND csv "${case},${case_ms}\n")
+
+    yk_ct_object_size(${case} case_bytes)
+    string(APPEND size_csv "${case},${case_bytes}\n")
+
+    if(DEFINED YK_CT_PREREQUISITE_${case})
+        math(EXPR total_ms "${prerequisite_ms} + ${case_ms}")
+        string(APPEND csv "${case} (total),${total_ms}\n")
+    endif()
+endforeach()
+
+message("${csv}")
+message("${size_csv}")
+file(WRITE "${BUILD_DIR}/compile_time.csv" "${csv}")
+file(WRITE "${BUILD_DIR}/object_size.csv" "${size_csv}")
@@ -0,0 +1,53 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Included by every generated translation unit after the library has been made
+// available, either by `#include` or by `import`, and after "workload_types.hpp".
+// The functions are TU-local so that each TU instantiates the same set of
+// specializations independently.
+
+namespace {
+
+using yk_ct::Value;
+using yk_ct::Binary;
+using yk_ct::Expr;
+
+int evaluate(Expr const& expr)
+{
+    return expr.visit(yk::overloaded{
+        [](int i) { return i; },
+        [](Binary const& bin) { return evaluate(bin.lhs) + evaluate(bin.rhs); },
+    });
+}
+
+std::size_t workload(int const seed)
+{
+    Value a{seed};
+    Value b{std::to_string(seed)};
+    std::size_t n = 0;
+
+    n += a == b;
+    n += a < b;
+    n += std::hash<Value>{}(a);
+
+    b = a;
+    b.emplace<std::string>(static_cast<std::size_t>(seed % 8), 'x');
+    Value c{std::move(b)};
+
+    n += yk::visit(yk::overloaded{
+        [](int i) { return static_cast<std::size_t>(i); },
+        [](double d) { return static_cast<std::size_t>(d); },
+        [](std::string const& s) { return s.size(); },
+        [](long long l) { return static_cast<std::size_t>(l); },
+        [](char ch) { return static_cast<std::size_t>(ch); },
+    }, c);
+    n += yk::holds_alternative<std::string>(c);
+    n += yk::get_if<int>(&a) != nullptr;
+
+    Expr expr{Binary{Expr{seed}, Expr{Binary{Expr{1}, Expr{2}}}}};
+    n += static_cast<std::size_t>(evaluate(expr));
+    return n;
+}
+
+} // anonymous
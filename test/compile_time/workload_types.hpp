@@ -0,0 +1,26 @@
+﻿#ifndef YK_RVARIANT_TEST_COMPILE_TIME_WORKLOAD_TYPES_HPP
+#define YK_RVARIANT_TEST_COMPILE_TIME_WORKLOAD_TYPES_HPP
+
+// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// The variant types used by workload.ipp. They have external linkage so that
+// the `extern_template` case can instantiate them in a single translation unit.
+// Included after the library has been made available, either by `#include` or
+// by `import`.
+
+namespace yk_ct {
+
+using Value = yk::rvariant<int, double, std::string, long long, char>;
+
+struct Binary;
+using Expr = yk::rvariant<int, yk::recursive_wrapper<Binary>>;
+struct Binary
+{
+    Expr lhs, rhs;
+};
+
+} // yk_ct
+
+#endif
@@ -33,12 +33,15 @@ TEST_CASE("exactly_once", "[core]")
 {
     STATIC_REQUIRE(yk::core::exactly_once_v<int, yk::core::type_list<int, float>>);
     STATIC_REQUIRE_FALSE(yk::core::exactly_once_v<int, yk::core::type_list<int, int>>);
+    STATIC_REQUIRE_FALSE(yk::core::exactly_once_v<int, yk::core::type_list<float, double>>);
+    STATIC_REQUIRE_FALSE(yk::core::exactly_once_v<int, yk::core::type_list<float, int, double, int>>);
 }
 
 TEST_CASE("is_in", "[core]")
 {
     STATIC_REQUIRE(yk::core::is_in_v<int, int, float>);
     STATIC_REQUIRE_FALSE(yk::core::is_in_v<int, float>);
+    STATIC_REQUIRE_FALSE(yk::core::is_in_v<int>);
 }
 
 TEST_CASE("find_index", "[core]")
@@ -49,6 +52,8 @@ TEST_CASE("find_index", "[core]")
     STATIC_REQUIRE(yk::core::find_index_v<int,    yk::core::type_list<float, double>> == yk::core::find_npos);
 
     STATIC_REQUIRE(yk::core::find_index_v<int, yk::core::type_list<int, int, double>> == 0);
+    STATIC_REQUIRE(yk::core::find_index_v<int, yk::core::type_list<double, int, int>> == 1);
+    STATIC_REQUIRE(yk::core::find_index_v<int, yk::core::type_list<>> == yk::core::find_npos);
 }
 
 TEST_CASE("Cpp17EqualityComparable", "[core]")
@@ -0,0 +1,146 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/rvariant_io.hpp"
+#include "yk/rvariant/recursive_wrapper.hpp"
+#include "yk/rvariant/explicit_instantiation.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace unit_test::explicit_instantiation {
+
+struct Binary;
+using Expr = yk::rvariant<int, yk::recursive_wrapper<Binary>>;
+
+struct Binary
+{
+    Expr lhs, rhs;
+    friend bool operator==(Binary const&, Binary const&) = default;
+};
+
+// equality comparable and hashable, but not three-way comparable
+struct EqOnly
+{
+    int value = 0;
+    friend bool operator==(EqOnly const&, EqOnly const&) = default;
+};
+
+// neither copyable, comparable, hashable nor ostreamable
+struct MoveOnly
+{
+    std::unique_ptr<int> p;
+};
+
+// neither copyable nor movable
+struct Immovable
+{
+    Immovable() = default;
+    Immovable(Immovable const&) = delete;
+    Immovable& operator=(Immovable const&) = delete;
+};
+
+} // unit_test::explicit_instantiation
+
+template<>
+struct std::hash<unit_test::explicit_instantiation::EqOnly>
+{
+    static std::size_t operator()(unit_test::explicit_instantiation::EqOnly const& x) noexcept
+    {
+        return std::hash<int>{}(x.value);
+    }
+};
+
+// Usually placed in a header (declaration) and in a single source file (definition),
+// respectively; both are placed here to check that each expansion is well-formed.
+YK_RVARIANT_EXTERN_TEMPLATE(int, std::string, double);
+YK_RVARIANT_EXTERN_TEMPLATE(int, yk::recursive_wrapper<unit_test::explicit_instantiation::Binary>);
+YK_RVARIANT_EXTERN_TEMPLATE(int, unit_test::explicit_instantiation::EqOnly);
+YK_RVARIANT_EXTERN_TEMPLATE(int, unit_test::explicit_instantiation::MoveOnly);
+YK_RVARIANT_EXTERN_TEMPLATE(int, unit_test::explicit_instantiation::Immovable);
+YK_RVARIANT_EXTERN_TEMPLATE_IO(int, std::string, double);
+
+YK_RVARIANT_INSTANTIATE(int, std::string, double);
+YK_RVARIANT_INSTANTIATE(int, yk::recursive_wrapper<unit_test::explicit_instantiation::Binary>);
+YK_RVARIANT_INSTANTIATE(int, unit_test::explicit_instantiation::EqOnly);
+YK_RVARIANT_INSTANTIATE(int, unit_test::explicit_instantiation::MoveOnly);
+YK_RVARIANT_INSTANTIATE(int, unit_test::explicit_instantiation::Immovable);
+YK_RVARIANT_INSTANTIATE_IO(int, std::string, double);
+
+namespace unit_test {
+
+TEST_CASE("explicit instantiation")
+{
+    using namespace explicit_instantiation;
+
+    {
+        using V = yk::rvariant<int, std::string, double>;
+        V a{42}, b{std::string("foo")};
+        V c = a;
+        CHECK(c == a);
+        CHECK(a != b);
+        CHECK(a < b);
+        CHECK((a <=> b) < 0);
+        c = b;
+        CHECK(yk::get<1>(c) == "foo");
+        c = V{3.14};
+        CHECK(c.index() == 2);
+        CHECK(std::hash<V>{}(a) == std::hash<V>{}(V{42}));
+
+        std::ostringstream oss;
+        oss << a << ' ' << b;
+        CHECK(oss.str() == "42 foo");
+    }
+    {
+        Expr const e{Binary{Expr{1}, Expr{2}}};
+        Expr copy = e;
+        CHECK(copy == e);
+        copy = Expr{3};
+        CHECK(copy != e);
+    }
+    {
+        using V = yk::rvariant<int, EqOnly>;
+        STATIC_REQUIRE(!std::three_way_comparable<V>);
+        V const a{EqOnly{42}}, b{std::in_place_index<0>, 42};
+        CHECK(a == V{EqOnly{42}});
+        CHECK(a != b);
+        CHECK(std::hash<V>{}(a) == std::hash<V>{}(V{EqOnly{42}}));
+        CHECK(std::hash<V>{}(a) != std::hash<V>{}(b));
+    }
+    {
+        // same, without explicit instantiation
+        using V = yk::rvariant<EqOnly, double>;
+        STATIC_REQUIRE(!std::three_way_comparable<V>);
+        V const a{EqOnly{1}}, b{std::in_place_index<1>, 1.0};
+        CHECK(a == V{EqOnly{1}});
+        CHECK(a != b);
+        CHECK(yk::hash_value(a) == yk::hash_value(V{EqOnly{1}}));
+    }
+    {
+        using V = yk::rvariant<int, MoveOnly>;
+        STATIC_REQUIRE(!std::is_copy_constructible_v<V>);
+        V a{MoveOnly{std::make_unique<int>(42)}};
+        V b = std::move(a);
+        CHECK(*yk::get<1>(b).p == 42);
+        a = 1;
+        b = std::move(a);
+        CHECK(yk::get<0>(b) == 1);
+    }
+    {
+        using V = yk::rvariant<int, Immovable>;
+        STATIC_REQUIRE(!std::is_move_constructible_v<V>);
+        V a{std::in_place_index<1>};
+        CHECK(a.index() == 1);
+    }
+}
+
+} // unit_test
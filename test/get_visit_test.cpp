@@ -762,4 +762,231 @@ TEST_CASE("visit", "[wrapper]")
     }
 }
 
+TEST_CASE("visit_commutative")
+{
+    using SI = strong<int>;
+    using SD = strong<double>;
+    using SC = strong<char>;
+
+    {
+        // no overload for `(SD, SI)`, `(SC, SI)` and `(SC, SD)`
+        constexpr auto vis = yk::overloaded{
+            [](SI const&, SI const&) { return 0; },
+            [](SI const&, SD const&) { return 1; },
+            [](SI const&, SC const&) { return 2; },
+            [](SD const&, SD const&) { return 3; },
+            [](SD const&, SC const&) { return 4; },
+            [](SC const&, SC const&) { return 5; },
+        };
+        using V = yk::rvariant<SI, SD, SC>;
+        STATIC_CHECK(yk::visit_commutative(vis, V{SI{}}, V{SI{}}) == 0);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SI{}}, V{SD{}}) == 1);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SD{}}, V{SI{}}) == 1);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SI{}}, V{SC{}}) == 2);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SC{}}, V{SI{}}) == 2);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SD{}}, V{SD{}}) == 3);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SD{}}, V{SC{}}) == 4);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SC{}}, V{SD{}}) == 4);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SC{}}, V{SC{}}) == 5);
+
+        STATIC_CHECK(yk::visit_commutative<long>(vis, V{SC{}}, V{SI{}}) == 2L);
+        STATIC_REQUIRE(std::is_same_v<decltype(yk::visit_commutative<long>(vis, V{SC{}}, V{SI{}})), long>);
+
+        V const a{SD{}};
+        V b{SI{}};
+        CHECK(yk::visit_commutative(vis, a, b) == 1);
+        CHECK(yk::visit_commutative(vis, b, a) == 1);
+        CHECK(yk::visit_commutative(vis, std::move(b), a) == 1);
+    }
+    {
+        // mixed cv or value categories are passed as the common reference type
+        constexpr auto vis = yk::overloaded{
+            [](auto&, auto&) { return 0; },
+            [](auto const&, auto const&) { return 1; },
+            [](auto&&, auto&&) { return 2; },
+        };
+        using V = yk::rvariant<SI, SD>;
+        V a{SI{}};
+        V b{SD{}};
+        V const c{SD{}};
+        CHECK(yk::visit_commutative(vis, a, b) == 0);
+        CHECK(yk::visit_commutative(vis, b, a) == 0);
+        CHECK(yk::visit_commutative(vis, a, c) == 1);
+        CHECK(yk::visit_commutative(vis, c, a) == 1);
+        CHECK(yk::visit_commutative(vis, std::move(a), b) == 1);
+        CHECK(yk::visit_commutative(vis, std::move(a), std::move(b)) == 2);
+        STATIC_REQUIRE(std::is_same_v<yk::detail::visit_commutative_variant_t<V&, V const&>, V const&>);
+        STATIC_REQUIRE(std::is_same_v<yk::detail::visit_commutative_variant_t<V&&, V&>, V const&>);
+        STATIC_REQUIRE(std::is_same_v<yk::detail::visit_commutative_variant_t<V, V const>, V const&&>);
+    }
+    {
+        constexpr auto vis = yk::overloaded{
+            [](SI /* unwrapped */ const&, SI /* unwrapped */ const&) { return 0; },
+            [](SI /* unwrapped */ const&, SD const&) { return 1; },
+            [](SD const&, SD const&) { return 2; },
+        };
+        using V = yk::rvariant<yk::recursive_wrapper<SI>, SD>;
+        STATIC_CHECK(yk::visit_commutative(vis, V{SI{}}, V{SI{}}) == 0);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SD{}}, V{SI{}}) == 1);
+        STATIC_CHECK(yk::visit_commutative(vis, V{SD{}}, V{SD{}}) == 2);
+    }
+    {
+        yk::rvariant<int, MC_Thrower> valueless = make_valueless<int>();
+        yk::rvariant<int, MC_Thrower> const i{42};
+        auto const vis = [](auto const&, auto const&) {};
+        CHECK_THROWS(yk::visit_commutative(vis, valueless, i));
+        CHECK_THROWS(yk::visit_commutative(vis, i, valueless));
+        CHECK_THROWS(yk::visit_commutative<void>(vis, valueless, valueless));
+    }
+}
+
+TEST_CASE("visit_same")
+{
+    using SI = strong<int>;
+    using SD = strong<double>;
+    using SC = strong<char>;
+
+    {
+        // no overload for the pairs of different types
+        constexpr auto vis = yk::overloaded{
+            [](SI const&, SI const&) { return 0; },
+            [](SD const&, SD const&) { return 1; },
+            [](SC const&, SC const&) { return 2; },
+        };
+        using V = yk::rvariant<SI, SD, SC>;
+        constexpr auto mismatch = [](V const& a, V const& b) { return static_cast<int>(10 * a.index() + b.index()) + 100; };
+
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SI{}}, V{SI{}}) == 0);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SD{}}, V{SD{}}) == 1);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SC{}}, V{SC{}}) == 2);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SI{}}, V{SD{}}) == 101);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SC{}}, V{SI{}}) == 120);
+
+        STATIC_CHECK(yk::visit_same<long>(vis, mismatch, V{SD{}}, V{SD{}}) == 1L);
+        STATIC_REQUIRE(std::is_same_v<decltype(yk::visit_same<long>(vis, mismatch, V{SD{}}, V{SD{}})), long>);
+
+        V const a{SD{}};
+        V b{SD{}};
+        CHECK(yk::visit_same(vis, mismatch, a, b) == 1);
+        CHECK(yk::visit_same(vis, mismatch, std::move(b), a) == 1);
+    }
+    {
+        // only the pairs of the same type must agree on the result type
+        constexpr auto vis = yk::overloaded{
+            [](SI const&, SI const&) { return 0; },
+            [](SD const&, SD const&) { return 1; },
+            [](auto const&, auto const&) { return "unused"; },
+        };
+        using V = yk::rvariant<SI, SD>;
+        constexpr auto mismatch = [](auto const&, auto const&) { return -1; };
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SD{}}, V{SD{}}) == 1);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SI{}}, V{SD{}}) == -1);
+
+        using Vis = decltype(vis) const&;
+        STATIC_REQUIRE(yk::detail::visit_seq_check<int, Vis, yk::detail::visit_same_impl<int, V>::CheckSeq, V&&, V&&>::value);
+        STATIC_REQUIRE(!yk::detail::visit_check<int, Vis, V&&, V&&>::value);
+    }
+    {
+        constexpr auto vis = yk::overloaded{
+            [](SI /* unwrapped */ const&, SI /* unwrapped */ const&) { return 0; },
+            [](SD const&, SD const&) { return 1; },
+        };
+        using V = yk::rvariant<yk::recursive_wrapper<SI>, SD>;
+        constexpr auto mismatch = [](auto const&, auto const&) { return -1; };
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SI{}}, V{SI{}}) == 0);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SD{}}, V{SD{}}) == 1);
+        STATIC_CHECK(yk::visit_same(vis, mismatch, V{SI{}}, V{SD{}}) == -1);
+    }
+    {
+        yk::rvariant<int, MC_Thrower> valueless = make_valueless<int>();
+        yk::rvariant<int, MC_Thrower> const i{42};
+        auto const vis = [](auto const&, auto const&) { return 0; };
+        auto const mismatch = [](auto const&, auto const&) { return 1; };
+        CHECK(yk::visit_same(vis, mismatch, valueless, i) == 1);
+        CHECK(yk::visit_same(vis, mismatch, i, valueless) == 1);
+        CHECK_THROWS(yk::visit_same(vis, mismatch, valueless, valueless));
+    }
+}
+
+TEST_CASE("visit_some")
+{
+    using SI = strong<int>;
+    using SD = strong<double>;
+    using SC = strong<char>;
+    using SW = strong<wchar_t>;
+
+    {
+        // no overload for `SC` and `SW`
+        constexpr auto vis = yk::overloaded{
+            [](SI const&) { return 0; },
+            [](SD const&) { return 1; },
+        };
+        using V = yk::rvariant<SI, SD, SC, SW>;
+        constexpr auto fallback = [](V const& v) { return static_cast<int>(v.index()) + 100; };
+
+        STATIC_CHECK(yk::visit_some<0, 1>(V{SI{}}, vis, fallback) == 0);
+        STATIC_CHECK(yk::visit_some<0, 1>(V{SD{}}, vis, fallback) == 1);
+        STATIC_CHECK(yk::visit_some<0, 1>(V{SC{}}, vis, fallback) == 102);
+        STATIC_CHECK(yk::visit_some<0, 1>(V{SW{}}, vis, fallback) == 103);
+        STATIC_CHECK(yk::visit_some<1, 0>(V{SI{}}, vis, fallback) == 0);
+        STATIC_CHECK(yk::visit_some<1>(V{SI{}}, vis, fallback) == 100);
+
+        STATIC_CHECK(yk::visit_some<SI, SD>(V{SI{}}, vis, fallback) == 0);
+        STATIC_CHECK(yk::visit_some<SD>(V{SD{}}, vis, fallback) == 1);
+        STATIC_CHECK(yk::visit_some<SD>(V{SW{}}, vis, fallback) == 103);
+
+        V v{SD{}};
+        SD& x = yk::visit_some<SD>(v, [](SD& alt) -> SD& { return alt; }, [](V&) -> SD& { throw std::exception{}; });
+        CHECK(&x == &yk::get<SD>(v));
+    }
+    {
+        // only the selected alternatives must agree on the result type
+        constexpr auto vis = yk::overloaded{
+            [](SI const&) { return 0; },
+            [](SD const&) { return 1; },
+            [](auto const&) { return "unused"; },
+        };
+        using V = yk::rvariant<SI, SD, SC>;
+        constexpr auto fallback = [](V const&) { return -1; };
+        STATIC_CHECK(yk::visit_some<0, 1>(V{SD{}}, vis, fallback) == 1);
+        STATIC_CHECK(yk::visit_some<0, 1>(V{SC{}}, vis, fallback) == -1);
+
+        using Vis = decltype(vis) const&;
+        STATIC_REQUIRE(yk::detail::visit_seq_check<int, Vis, yk::detail::visit_some_impl<int, V, 0, 1>::CheckSeq, V&&>::value);
+        STATIC_REQUIRE(!yk::detail::visit_seq_check<int, Vis, yk::detail::visit_some_impl<int, V, 0, 2>::CheckSeq, V&&>::value);
+    }
+    {
+        constexpr auto vis = [](SI /* unwrapped */ const&) { return 0; };
+        using V = yk::rvariant<SD, yk::recursive_wrapper<SI>>;
+        constexpr auto fallback = [](auto const&) { return -1; };
+        STATIC_CHECK(yk::visit_some<SI>(V{SI{}}, vis, fallback) == 0);
+        STATIC_CHECK(yk::visit_some<1>(V{SI{}}, vis, fallback) == 0);
+        STATIC_CHECK(yk::visit_some<1>(V{SD{}}, vis, fallback) == -1);
+    }
+    {
+        using V = many_V_t<33>;
+        constexpr auto fallback = [](V const&) { return -1; };
+        constexpr auto vis = [](auto const& x) { return x.value; };
+        STATIC_CHECK(yk::visit_some<3, 32>(V(std::in_place_index<3>), vis, fallback) == 3 * 2);
+        STATIC_CHECK(yk::visit_some<3, 32>(V(std::in_place_index<32>), vis, fallback) == 32 * 2);
+        STATIC_CHECK(yk::visit_some<3, 32>(V(std::in_place_index<31>), vis, fallback) == -1);
+    }
+    {
+        // more than 64 alternatives; no bitmask
+        using V = many_V_t<66>;
+        constexpr auto fallback = [](V const&) { return -1; };
+        constexpr auto vis = [](auto const& x) { return x.value; };
+        STATIC_CHECK(yk::visit_some<3, 65>(V(std::in_place_index<3>), vis, fallback) == 3 * 2);
+        STATIC_CHECK(yk::visit_some<3, 65>(V(std::in_place_index<65>), vis, fallback) == 65 * 2);
+        STATIC_CHECK(yk::visit_some<3, 65>(V(std::in_place_index<40>), vis, fallback) == -1);
+    }
+    {
+        yk::rvariant<int, MC_Thrower> valueless = make_valueless<int>();
+        auto const vis = [](int) { return 0; };
+        auto const fallback = [](auto const&) { return 1; };
+        CHECK(yk::visit_some<int>(valueless, vis, fallback) == 1);
+        CHECK(yk::visit_some<0>(yk::rvariant<int, MC_Thrower>{42}, vis, fallback) == 0);
+    }
+}
+
 } // unit_test
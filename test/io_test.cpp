@@ -50,8 +50,10 @@ struct NonStreamable {};
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <ranges>
 #include <string>
 #include <sstream>
+#include <vector>
 
 
 namespace unit_test {
@@ -304,6 +306,100 @@ TEST_CASE("rvariant.io", "[recursive]")
     }
 }
 
+TEST_CASE("rvariant.io, write_all")
+{
+    using S_ns::S;
+    using ThrowingValue_ns::ThrowingValue;
+
+    {
+        std::vector<yk::rvariant<int, S>> const vars{42, S{"foo"}, 12};
+        std::ostringstream oss;
+        yk::write_all(oss, vars, ", ");
+        CHECK(oss.str() == "42, foo, 12");
+    }
+    {
+        std::vector<yk::rvariant<int, S>> const vars{42, S{"foo"}};
+        std::ostringstream oss;
+        yk::write_all(oss, vars, '|');
+        CHECK(oss.str() == "42|foo");
+    }
+    {
+        std::vector<yk::rvariant<int, S>> const vars;
+        std::ostringstream oss;
+        yk::write_all(oss, vars);
+        CHECK(oss.str().empty());
+        CHECK(oss.good());
+    }
+    {
+        std::vector<yk::rvariant<yk::recursive_wrapper<int>>> const vars{1, 2, 3};
+        std::ostringstream oss;
+        yk::write_all(oss, vars | std::views::reverse, " ");
+        CHECK(oss.str() == "3 2 1");
+    }
+
+    // stream settings are restored
+    {
+        std::vector<yk::rvariant<int>> const vars{1, 2};
+        std::ostringstream tied;
+        std::ostringstream oss;
+        oss.tie(&tied);
+        oss.setf(std::ios_base::unitbuf);
+        yk::write_all(oss, vars, " ");
+        CHECK(oss.str() == "1 2");
+        CHECK(oss.tie() == &tied);
+        CHECK((oss.flags() & std::ios_base::unitbuf) != 0);
+    }
+
+    // bad at first
+    {
+        std::vector<yk::rvariant<int>> const vars{1, 2};
+        std::ostringstream oss;
+        oss.setstate(std::ios_base::badbit);
+        REQUIRE_NOTHROW(yk::write_all(oss, vars, " "));
+        CHECK(oss.str().empty());
+        CHECK((oss.rdstate() & std::ios_base::badbit) != 0);
+    }
+    // output stops at the first failing element
+    {
+        std::vector<yk::rvariant<ThrowingValue>> const vars(2);
+        std::ostringstream oss;
+        REQUIRE_NOTHROW(yk::write_all(oss, vars, " "));
+        CHECK(oss.str() == "ThrowingValue");
+        CHECK((oss.rdstate() & std::ios_base::badbit) != 0);
+    }
+    {
+        std::vector<yk::rvariant<ThrowingValue>> const vars(2);
+        std::ostringstream oss;
+        oss.exceptions(std::ios_base::badbit);
+        REQUIRE_THROWS_AS(yk::write_all(oss, vars, " "), ThrowingValue_ns::StrangeException);
+        CHECK(oss.str() == "ThrowingValue");
+        CHECK((oss.rdstate() & std::ios_base::badbit) != 0);
+    }
+
+    // valueless always throws, without setting badbit
+    {
+        std::vector<yk::rvariant<int, MC_Thrower>> vars;
+        vars.reserve(2);
+        vars.emplace_back(42);
+        vars.emplace_back(make_valueless<int>());
+        std::ostringstream oss;
+        REQUIRE_THROWS_AS(yk::write_all(oss, vars, " "), std::bad_variant_access);
+        CHECK(oss.str() == "42 ");
+        CHECK((oss.rdstate() & std::ios_base::badbit) == 0);
+    }
+}
+
+#if __cpp_lib_format_ranges
+TEST_CASE("rvariant formatter (range)")
+{
+    using V = yk::rvariant<int, std::string>;
+    std::vector<V> const vars{42, "ab"};
+    CHECK(std::format("{}", vars) == "[42, ab]");
+    CHECK(std::format("{::>3}", vars) == "[ 42,  ab]");
+    CHECK(std::format("{:n:>3}", vars) == " 42,  ab");
+}
+#endif
+
 TEST_CASE("rvariant formatter (char)")
 {
     using V = yk::rvariant<int, double>;
@@ -388,6 +484,37 @@ TEST_CASE("rvariant formatter (wchar_t)")
     }
 }
 
+TEST_CASE("rvariant formatter spec")
+{
+    {
+        using V = yk::rvariant<int, std::string>;
+        CHECK(std::format("[{:>4}]", V{42}) == "[  42]");
+        CHECK(std::format("[{:>4}]", V{"ab"}) == "[  ab]");
+        CHECK(std::format("[{:*<5}]", V{"ab"}) == "[ab***]");
+    }
+    {
+        using V = yk::rvariant<int, std::wstring>;
+        CHECK(std::format(L"[{:>4}]", V{42}) == L"[  42]");
+        CHECK(std::format(L"[{:>4}]", V{L"ab"}) == L"[  ab]");
+    }
+    {
+        using V = yk::rvariant<double, float>;
+        CHECK(std::format("{:.1f}", V{3.14}) == "3.1");
+        CHECK(std::format("{:.1f}", V{2.5f}) == "2.5");
+    }
+    {
+        using V = yk::rvariant<int, std::string>;
+        V v{42};
+        // `d` is not a valid spec for std::string
+        CHECK_THROWS_AS(std::vformat("{:d}", std::make_format_args(v)), std::format_error);
+    }
+    {
+        using V = yk::rvariant<int, yk::recursive_wrapper<std::string>>;
+        CHECK(std::format("[{:>4}]", V{42}) == "[  42]");
+        CHECK(std::format("[{:>4}]", V{std::string{"ab"}}) == "[  ab]");
+    }
+}
+
 TEST_CASE("rvariant formatter (char)", "[recursive]")
 {
     CHECK(std::format("{}", yk::rvariant<yk::recursive_wrapper<int>>{42}) == "42");
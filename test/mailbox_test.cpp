@@ -0,0 +1,164 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/mailbox.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cstdint>
+
+namespace unit_test {
+
+namespace {
+
+struct ThrowOnConstruct
+{
+    struct exception {};
+    explicit ThrowOnConstruct(int) { throw exception{}; }
+};
+
+struct Counted
+{
+    static inline int live = 0;
+
+    int value;
+    explicit Counted(int value) noexcept : value(value) { ++live; }
+    Counted(Counted const& other) noexcept : value(other.value) { ++live; }
+    ~Counted() noexcept { --live; }
+};
+
+} // anonymous
+
+TEST_CASE("mailbox")
+{
+    using V = yk::rvariant<int, std::string, ThrowOnConstruct, Counted>;
+
+    {
+        yk::mailbox<V> mb(5);
+        CHECK(mb.capacity() == 8);
+
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(mb.try_emplace<0>(i));
+        }
+        CHECK_FALSE(mb.try_emplace<0>(99)); // full
+
+        std::vector<int> ints;
+        auto const collect = [&]<class T>(T const& x) {
+            if constexpr (std::is_same_v<T, int>) ints.push_back(x);
+        };
+        CHECK(mb.drain(collect, 3) == 3);
+        CHECK(ints == std::vector<int>{0, 1, 2});
+        CHECK(mb.drain(collect) == 5);
+        CHECK(ints == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7});
+        CHECK(mb.drain(collect) == 0);
+    }
+    {
+        yk::mailbox<V> mb(8);
+        REQUIRE(mb.try_emplace<1>("a"));
+        REQUIRE(mb.try_emplace<0>(1));
+        REQUIRE(mb.try_emplace<std::string>("b"));
+        REQUIRE(mb.try_emplace<0>(2));
+        CHECK_THROWS_AS(mb.try_emplace<2>(0), ThrowOnConstruct::exception); // the slot is skipped
+        REQUIRE(mb.try_emplace<0>(3));
+
+        std::string order;
+        CHECK(mb.drain_grouped([&]<class T>(T const& x) {
+            if constexpr (std::is_same_v<T, int>) order += std::to_string(x);
+            else if constexpr (std::is_same_v<T, std::string>) order += x;
+        }) == 6);
+        CHECK(order == "123ab");
+    }
+    {
+        // a throwing visitor consumes only the messages visited so far
+        struct visitor_exception {};
+        for (bool const grouped_again : {false, true}) {
+            yk::mailbox<V> mb(8);
+            REQUIRE(mb.try_emplace<0>(1));
+            REQUIRE(mb.try_emplace<1>("a"));
+            REQUIRE(mb.try_emplace<0>(2));
+            REQUIRE(mb.try_emplace<1>("b"));
+            REQUIRE(mb.try_emplace<0>(3));
+
+            std::string order;
+            auto const collect = [&]<class T>(T const& x) {
+                if constexpr (std::is_same_v<T, int>) order += std::to_string(x);
+                else if constexpr (std::is_same_v<T, std::string>) order += x;
+            };
+            CHECK_THROWS_AS(mb.drain_grouped([&]<class T>(T const& x) {
+                collect(x);
+                if constexpr (std::is_same_v<T, int>) {
+                    if (x == 2) throw visitor_exception{};
+                }
+            }), visitor_exception);
+            CHECK(order == "12");
+
+            order.clear();
+            if (grouped_again) {
+                CHECK(mb.drain_grouped(collect) == 3);
+                CHECK(order == "3ab");
+            } else {
+                CHECK(mb.drain(collect) == 3);
+                CHECK(order == "ab3");
+            }
+            CHECK(mb.drain(collect) == 0);
+        }
+    }
+    {
+        // wrap around, and destruction of undrained messages
+        {
+            yk::mailbox<V> mb(4);
+            for (int i = 0; i < 20; ++i) {
+                REQUIRE(mb.try_emplace<Counted>(i));
+                CHECK(mb.drain([](auto const&) {}) == 1);
+            }
+            REQUIRE(mb.try_emplace<Counted>(1));
+            REQUIRE(mb.try_emplace<Counted>(2));
+            CHECK(Counted::live == 2);
+        }
+        CHECK(Counted::live == 0);
+    }
+}
+
+TEST_CASE("mailbox (concurrent)")
+{
+    constexpr int producers = 4;
+    constexpr std::uint32_t messages = 10000;
+    using V = yk::rvariant<int, std::uint64_t>;
+    yk::mailbox<V> mb(64);
+
+    std::vector<std::jthread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&mb, p] {
+            for (std::uint32_t i = 0; i < messages; ++i) {
+                auto const msg = static_cast<std::uint64_t>(p) << 32 | i;
+                while (!mb.try_emplace<1>(msg)) std::this_thread::yield();
+            }
+        });
+    }
+
+    // messages from each producer arrive in order
+    std::vector<std::int64_t> last(producers, -1);
+    bool in_order = true;
+    std::size_t total = 0;
+    while (total < producers * messages) {
+        total += mb.drain_grouped([&]<class T>(T const& x) {
+            if constexpr (std::is_same_v<T, std::uint64_t>) {
+                auto const p = static_cast<std::size_t>(x >> 32);
+                auto const i = static_cast<std::int64_t>(x & 0xffffffff);
+                in_order &= i == last[p] + 1;
+                last[p] = i;
+            }
+        }, 16);
+    }
+    CHECK(in_order);
+    CHECK(total == producers * messages);
+}
+
+} // unit_test
@@ -0,0 +1,64 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <format>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+import yk.rvariant.io;
+
+namespace unit_test {
+
+namespace {
+
+struct Binary;
+using Expr = yk::rvariant<int, yk::recursive_wrapper<Binary>>;
+struct Binary
+{
+    Expr lhs, rhs;
+};
+
+int evaluate(Expr const& expr)
+{
+    return expr.visit(yk::overloaded{
+        [](int i) { return i; },
+        [](Binary const& bin) { return evaluate(bin.lhs) + evaluate(bin.rhs); },
+    });
+}
+
+} // anonymous
+
+TEST_CASE("named module")
+{
+    using V = yk::rvariant<int, std::string>;
+
+    STATIC_REQUIRE(yk::variant_size_v<V> == 2);
+    STATIC_REQUIRE(std::is_same_v<yk::variant_alternative_t<1, V>, std::string>);
+    STATIC_REQUIRE(yk::rvariant_set::subset_of<yk::rvariant<int>, V>);
+
+    V a{42}, b{std::string("foo")};
+    CHECK(yk::holds_alternative<int>(a));
+    CHECK(yk::get<0>(a) == 42);
+    CHECK(yk::get_if<std::string>(&b) != nullptr);
+    CHECK(a != b);
+    CHECK(a < b);
+    CHECK(std::hash<V>{}(a) == yk::hash_value(a));
+    CHECK(yk::visit([](auto const& x) { return sizeof(x) != 0; }, b));
+
+    b.emplace<int>(42);
+    CHECK(a == b);
+
+    CHECK(evaluate(Expr{Binary{Expr{1}, Expr{Binary{Expr{2}, Expr{3}}}}}) == 6);
+
+    std::ostringstream oss;
+    oss << a;
+    CHECK(oss.str() == "42");
+    CHECK(std::format("{}", V{std::string("bar")}) == "bar");
+}
+
+} // unit_test
@@ -0,0 +1,164 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/parallel_tree.hpp"
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/recursive_wrapper.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <cstddef>
+
+namespace unit_test {
+
+namespace {
+
+struct allocation_counter
+{
+    std::atomic<std::size_t> count{0};
+    std::size_t limit = static_cast<std::size_t>(-1);
+};
+
+// Stateful allocator; copies of a wrapper keep the allocator of the source
+template<class T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    allocation_counter* counter;
+
+    explicit counting_allocator(allocation_counter* counter) noexcept : counter(counter) {}
+
+    template<class U>
+    counting_allocator(counting_allocator<U> const& other) noexcept : counter(other.counter) {}
+
+    T* allocate(std::size_t n)
+    {
+        if (counter->count.fetch_add(1) >= counter->limit) throw std::bad_alloc{};
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template<class U>
+    bool operator==(counting_allocator<U> const& other) const noexcept { return counter == other.counter; }
+};
+
+namespace json {
+
+struct Array;
+struct Object;
+
+using Value = yk::rvariant<
+    std::monostate,
+    double,
+    std::string,
+    yk::recursive_wrapper<Array>,
+    yk::recursive_wrapper<Object>
+>;
+
+struct Array : std::vector<Value>
+{
+    using vector::vector;
+};
+
+struct Object : std::map<std::string, Value, std::less<>>
+{
+    using map::map;
+};
+
+Value make_tree(std::size_t const depth, double& leaf)
+{
+    if (depth == 0) {
+        leaf += 1;
+        if (static_cast<int>(leaf) % 5 == 0) return std::string(32, 'x');
+        return leaf;
+    }
+    Array arr;
+    for (std::size_t i = 0; i < 4; ++i) {
+        arr.emplace_back(make_tree(depth - 1, leaf));
+    }
+    if (depth % 3 == 0) {
+        Object obj;
+        obj.try_emplace("child", std::move(arr));
+        return obj;
+    }
+    return arr;
+}
+
+} // json
+
+namespace counted {
+
+struct Array;
+
+using Value = yk::rvariant<int, yk::recursive_wrapper<Array, counting_allocator<Array>>>;
+
+struct Array : std::vector<Value>
+{
+    using vector::vector;
+};
+
+Value make_tree(std::size_t const depth, allocation_counter* counter)
+{
+    if (depth == 0) return 42;
+    Array arr;
+    for (std::size_t i = 0; i < 4; ++i) {
+        arr.emplace_back(make_tree(depth - 1, counter));
+    }
+    return Value(std::in_place_index<1>, std::allocator_arg, counting_allocator<Array>(counter), std::in_place, std::move(arr));
+}
+
+} // counted
+
+} // anonymous
+
+TEST_CASE("parallel_deep_copy")
+{
+    {
+        double leaf = 0;
+        json::Value const tree = json::make_tree(7, leaf);
+        for (std::size_t const threads : {1uz, 2uz, 4uz}) {
+            json::Value copy = yk::parallel_deep_copy(tree, threads);
+            CHECK(copy == tree);
+            yk::parallel_destroy(std::move(copy), threads);
+        }
+    }
+    {
+        json::Value const leaf = 3.14;
+        CHECK(yk::parallel_deep_copy(leaf, 4) == leaf);
+    }
+    {
+        // every node is allocated with the allocator of its source wrapper
+        allocation_counter counter;
+        counted::Value const tree = counted::make_tree(6, &counter);
+        std::size_t const nodes = counter.count;
+        CHECK(nodes == 1 + 4 + 16 + 64 + 256 + 1024);
+
+        counted::Value const copy = yk::parallel_deep_copy(tree, 4);
+        CHECK(copy == tree);
+        CHECK(counter.count == 2 * nodes);
+    }
+    {
+        // exception from an allocation is propagated, without leaking
+        allocation_counter counter;
+        counted::Value const tree = counted::make_tree(6, &counter);
+        counter.limit = counter.count + 100;
+        CHECK_THROWS_AS(yk::parallel_deep_copy(tree, 4), std::bad_alloc);
+    }
+}
+
+} // unit_test
@@ -0,0 +1,107 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/parallel_visit.hpp"
+#include "yk/rvariant/rvariant.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace unit_test {
+
+TEST_CASE("visit_each")
+{
+    using V = yk::rvariant<int, std::string, double>;
+
+    std::vector<V> vars;
+    long long expected = 0;
+    for (int i = 0; i < 20000; ++i) {
+        switch (i % 3) {
+        case 0: vars.emplace_back(i); expected += i; break;
+        case 1: vars.emplace_back(std::string(static_cast<std::size_t>(i % 7), 'a')); expected += i % 7; break;
+        default: vars.emplace_back(static_cast<double>(i)); expected += i; break;
+        }
+    }
+
+    std::atomic<long long> sum{0};
+    std::atomic<std::size_t> count{0};
+    auto const vis = yk::overloaded{
+        [&](int x) { sum += x; ++count; },
+        [&](std::string const& s) { sum += static_cast<long long>(s.size()); ++count; },
+        [&](double d) { sum += static_cast<long long>(d); ++count; },
+    };
+    auto const check = [&] {
+        CHECK(sum.exchange(0) == expected);
+        CHECK(count.exchange(0) == vars.size());
+    };
+
+    for (std::size_t const threads : {1uz, 3uz, 4uz}) {
+        yk::visit_each(yk::jthread_policy{threads}, vars, vis);
+        check();
+        yk::visit_each(yk::jthread_policy{threads}, std::as_const(vars), vis, yk::visit_cost_table<V>{1.0, 10.0, 2.0});
+        check();
+        yk::visit_each(yk::jthread_policy{threads}, yk::group_by_index, vars, vis);
+        check();
+        yk::visit_each(yk::jthread_policy{threads}, yk::group_by_index, vars, vis, yk::visit_cost_table<V>{1.0, 100.0, 0.0});
+        check();
+    }
+#if YK_RVARIANT_HAS_EXECUTION_POLICY
+    yk::visit_each(std::execution::seq, vars, vis);
+    check();
+    yk::visit_each(std::execution::seq, yk::group_by_index, vars, vis);
+    check();
+    yk::visit_each(std::execution::par, yk::group_by_index, vars, vis);
+    check();
+    {
+        // par_unseq: the visitor must not synchronize, so it only modifies the visited element
+        std::vector<V> actual = vars, expected_vars = vars;
+        auto const twice = yk::overloaded{
+            [](int& x) noexcept { x *= 2; },
+            [](std::string& s) noexcept { s.resize(s.size() / 2); },
+            [](double& d) noexcept { d *= 2; },
+        };
+        yk::visit_each(std::execution::par_unseq, yk::group_by_index, actual, twice);
+        for (auto& v : expected_vars) {
+            v.visit(twice);
+        }
+        CHECK(actual == expected_vars);
+    }
+#endif
+
+    {
+        // grouped: alternatives of each window are visited in the order of the index
+        std::vector<V> small{V{1}, V{2.0}, V{"a"}, V{3}, V{"b"}};
+        std::string order;
+        yk::visit_each(yk::jthread_policy{1}, yk::group_by_index, small, yk::overloaded{
+            [&](int x) { order += std::to_string(x); },
+            [&](std::string const& s) { order += s; },
+            [&](double) { order += 'd'; },
+        });
+        CHECK(order == "13abd");
+    }
+    {
+        std::vector<V> empty;
+        yk::visit_each(yk::jthread_policy{4}, empty, [](auto const&) {});
+    }
+    {
+        struct exception {};
+        CHECK_THROWS_AS(
+            yk::visit_each(yk::jthread_policy{4}, vars, []<class T>(T const& x) {
+                if constexpr (std::is_same_v<T, double>) {
+                    if (x == 10001.0) throw exception{};
+                }
+            }),
+            exception
+        );
+    }
+}
+
+} // unit_test
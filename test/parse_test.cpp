@@ -0,0 +1,119 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/rvariant_parse.hpp"
+#include "yk/rvariant/recursive_wrapper.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace unit_test {
+
+TEST_CASE("parse_into")
+{
+    using V = yk::rvariant<std::monostate, std::int64_t, double, bool, std::string_view>;
+
+    {
+        V v;
+        REQUIRE(yk::parse_into(v, "42"));
+        REQUIRE(v.index() == 1);
+        CHECK(yk::get<1>(v) == 42);
+
+        REQUIRE(yk::parse_into(v, "-3.5"));
+        REQUIRE(v.index() == 2);
+        CHECK(yk::get<2>(v) == -3.5);
+
+        REQUIRE(yk::parse_into(v, "1e3"));
+        REQUIRE(v.index() == 2);
+        CHECK(yk::get<2>(v) == 1000.0);
+
+        REQUIRE(yk::parse_into(v, "true"));
+        REQUIRE(v.index() == 3);
+        CHECK(yk::get<3>(v) == true);
+
+        REQUIRE(yk::parse_into(v, "false"));
+        REQUIRE(v.index() == 3);
+        CHECK(yk::get<3>(v) == false);
+
+        REQUIRE(yk::parse_into(v, ""));
+        CHECK(v.index() == 0);
+
+        REQUIRE(yk::parse_into(v, "42abc"));
+        REQUIRE(v.index() == 4);
+        CHECK(yk::get<4>(v) == "42abc");
+    }
+    {
+        auto const v = yk::parse_into<V>("42");
+        REQUIRE(v.has_value());
+        REQUIRE(v->index() == 1);
+        CHECK(yk::get<1>(*v) == 42);
+    }
+
+    // custom order
+    {
+        auto const v = yk::parse_into<V>("42", yk::parse_order<2, 1>{});
+        REQUIRE(v.has_value());
+        REQUIRE(v->index() == 2);
+        CHECK(yk::get<2>(*v) == 42.0);
+    }
+    {
+        V v{true};
+        CHECK_FALSE(yk::parse_into(v, "foo", yk::parse_order<1, 2>{}));
+        REQUIRE(v.index() == 3); // unchanged
+        CHECK(yk::get<3>(v) == true);
+
+        CHECK_FALSE(yk::parse_into<V>("foo", yk::parse_order<1, 2>{}).has_value());
+    }
+
+    // std::string, recursive_wrapper
+    {
+        using W = yk::rvariant<int, yk::recursive_wrapper<std::string>>;
+        W w;
+        REQUIRE(yk::parse_into(w, "abc"));
+        REQUIRE(w.index() == 1);
+        CHECK(yk::get<1>(w) == "abc");
+
+        REQUIRE(yk::parse_into(w, "123"));
+        REQUIRE(w.index() == 0);
+        CHECK(yk::get<0>(w) == 123);
+    }
+}
+
+TEST_CASE("parse_all")
+{
+    using V = yk::rvariant<std::monostate, std::int64_t, double, bool, std::string_view>;
+
+    std::array<std::string_view, 5> const fields{"1", "2.5", "", "true", "x"};
+    {
+        std::vector<V> out(fields.size());
+        REQUIRE(yk::parse_all(fields, out) == fields.size());
+        CHECK(out[0].index() == 1);
+        CHECK(out[1].index() == 2);
+        CHECK(out[2].index() == 0);
+        CHECK(out[3].index() == 3);
+        CHECK(out[4].index() == 4);
+    }
+    {
+        // stops at the first failure
+        std::vector<V> out(fields.size());
+        CHECK(yk::parse_all(fields, out, yk::parse_order<1, 2>{}) == 2);
+        CHECK(out[0].index() == 1);
+        CHECK(out[1].index() == 2);
+        CHECK(out[2].index() == 0); // untouched
+    }
+    {
+        // output shorter than input
+        std::vector<V> out(2);
+        CHECK(yk::parse_all(fields, out) == 2);
+    }
+}
+
+} // unit_test
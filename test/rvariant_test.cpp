@@ -13,6 +13,7 @@
 #include "yk/rvariant/pack.hpp"
 
 #include "yk/indirect.hpp"
+#include "yk/default_init_allocator.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -24,6 +25,7 @@
 #include <ranges>
 #include <bit>
 #include <array>
+#include <stdexcept>
 #include <print>
 
 #include <cstddef>
@@ -525,6 +527,155 @@ TEST_CASE("variant_index_t", "[detail]")
     STATIC_REQUIRE(yk::detail::valueless_bias<false>(static_cast<yk::detail::variant_index_t<128>>(127)) == 128);
 }
 
+struct PolicyBigType : Thrower_base
+{
+    std::byte dummy[yk::detail::never_valueless_trivial_size_limit + 1]{};
+};
+
+struct PolicyNothrowMove : Thrower_base
+{
+    using Thrower_base::Thrower_base;
+    std::string value;
+};
+
+struct PolicyTag
+{
+    friend bool operator==(PolicyTag const&, PolicyTag const&) = default;
+    friend auto operator<=>(PolicyTag const&, PolicyTag const&) = default;
+};
+
+} // unit_test
+
+template<>
+struct yk::rvariant_policy<int, unit_test::PolicyBigType>
+{
+    using index_type = unsigned char;
+    static constexpr std::size_t never_valueless_trivial_size_limit = 2 * yk::detail::never_valueless_trivial_size_limit;
+};
+
+template<>
+struct yk::rvariant_policy<int, unit_test::MC_Thrower, unit_test::PolicyTag>
+{
+    using index_type = unsigned char;
+    static constexpr std::size_t never_valueless_trivial_size_limit = yk::detail::never_valueless_trivial_size_limit;
+};
+
+template<>
+struct yk::rvariant_policy<int, std::string, unit_test::PolicyNothrowMove>
+{
+    // other members take the defaults
+    static constexpr bool nothrow_move_never_valueless = true;
+};
+
+namespace unit_test {
+
+TEST_CASE("rvariant_policy")
+{
+    STATIC_REQUIRE(std::is_same_v<yk::detail::rvariant_index_t<int, float>, yk::detail::variant_index_t<2>>);
+    STATIC_REQUIRE(std::is_same_v<yk::detail::rvariant_index_t<int, PolicyBigType>, unsigned char>);
+
+    // members missing from a specialization take the defaults
+    STATIC_REQUIRE(!yk::detail::rvariant_policy_traits<int, PolicyBigType>::nothrow_move_never_valueless);
+    STATIC_REQUIRE(std::is_same_v<yk::detail::rvariant_index_t<int, std::string, PolicyNothrowMove>, yk::detail::variant_index_t<3>>);
+    STATIC_REQUIRE(yk::detail::rvariant_policy_traits<int, std::string, PolicyNothrowMove>::never_valueless_trivial_size_limit == yk::detail::never_valueless_trivial_size_limit);
+
+    // size limit
+    {
+        STATIC_REQUIRE(!yk::detail::is_never_valueless_v<PolicyBigType>);
+        STATIC_REQUIRE(is_never_valueless<yk::rvariant<int, PolicyBigType>>);
+
+        yk::rvariant<int, PolicyBigType> a(42);
+        REQUIRE_THROWS_AS(a.emplace<1>(PolicyBigType::throwing), PolicyBigType::exception);
+        CHECK(a.valueless_by_exception() == false);
+        CHECK(a.index() == 0);
+        CHECK(yk::get<0>(a) == 42);
+
+        a.emplace<1>(PolicyBigType::non_throwing);
+        CHECK(a.index() == 1);
+    }
+    // conversion from a subset which may be valueless under its own policy
+    {
+        using V = yk::rvariant<int, PolicyBigType>;
+        using W = yk::rvariant<PolicyBigType>;
+        STATIC_REQUIRE(is_never_valueless<V>);
+        STATIC_REQUIRE(!is_never_valueless<W>);
+        STATIC_REQUIRE(!std::is_nothrow_constructible_v<V, W const&>);
+        STATIC_REQUIRE(!std::is_nothrow_assignable_v<V&, W&&>);
+
+        W w(std::in_place_index<0>, PolicyBigType::non_throwing);
+        REQUIRE_THROWS_AS(w.emplace<0>(PolicyBigType::throwing), PolicyBigType::exception);
+        REQUIRE(w.valueless_by_exception());
+
+        CHECK_THROWS_AS(V(w), std::bad_variant_access);
+        CHECK_THROWS_AS(V(std::move(w)), std::bad_variant_access);  // NOLINT(bugprone-use-after-move)
+
+        V a(42);
+        CHECK_THROWS_AS(a = w, std::bad_variant_access);
+        CHECK_THROWS_AS(a = std::move(w), std::bad_variant_access);  // NOLINT(bugprone-use-after-move)
+        REQUIRE(a.index() == 0); // unchanged
+        CHECK(yk::get<0>(a) == 42);
+
+        w.emplace<0>(PolicyBigType::non_throwing);
+        a = w;
+        CHECK(a.index() == 1);
+        V const b(w);
+        CHECK(b.index() == 1);
+    }
+    // unsigned index type
+    {
+        using V = yk::rvariant<int, MC_Thrower, PolicyTag>;
+        STATIC_REQUIRE(std::is_same_v<yk::detail::index_access<V>::index_type, unsigned char>);
+
+        V a(42);
+        CHECK(a.index() == 0);
+        a.emplace<PolicyTag>();
+        CHECK(a.index() == 2);
+
+        try {
+            V b(std::in_place_type<MC_Thrower>);
+            a = std::move(b);
+        } catch (MC_Thrower::exception const&) {  // NOLINT(bugprone-empty-catch)
+        }
+        REQUIRE(a.valueless_by_exception());
+        CHECK(a.index() == std::variant_npos);
+        CHECK_THROWS_AS(a.visit([](auto&&) {}), std::bad_variant_access);
+
+        V const valueless = a;
+        CHECK(valueless.valueless_by_exception());
+        CHECK(valueless == a);
+        CHECK(valueless < V(42));
+
+        a = 42;
+        CHECK(a.index() == 0);
+        CHECK(a != valueless);
+    }
+    // nothrow move constructible alternatives
+    {
+        using V = yk::rvariant<int, std::string, PolicyNothrowMove>;
+        STATIC_REQUIRE(!yk::detail::is_never_valueless_v<std::string, PolicyNothrowMove>);
+        STATIC_REQUIRE(is_never_valueless<V>);
+
+        V a(std::in_place_type<std::string>, "foo");
+        // type-changing
+        REQUIRE_THROWS_AS(a.emplace<PolicyNothrowMove>(Thrower_base::throwing), Thrower_base::exception);
+        CHECK(a.index() == 1);
+        CHECK(yk::get<1>(a) == "foo");
+
+        // non type-changing
+        REQUIRE_THROWS_AS(a.emplace<std::string>(std::string::npos, 'x'), std::length_error);
+        CHECK(a.index() == 1);
+        CHECK(yk::get<1>(a) == "foo");
+        a.emplace<std::string>(3uz, 'x');
+        CHECK(yk::get<1>(a) == "xxx");
+
+        a.emplace<PolicyNothrowMove>(Thrower_base::potentially_throwing).value = "bar";
+        CHECK(a.index() == 2);
+        REQUIRE_THROWS_AS(a.emplace<PolicyNothrowMove>(Thrower_base::throwing), Thrower_base::exception);
+        CHECK(a.index() == 2);
+        CHECK(yk::get<2>(a).value == "bar");
+    }
+}
+
 // --------------------------------------------
 
 TEST_CASE("helper class")
@@ -973,6 +1124,37 @@ TEST_CASE("move construction")
     }
 }
 
+TEST_CASE("for_overwrite construction")
+{
+    struct Packet
+    {
+        std::byte data[64];
+    };
+
+    STATIC_REQUIRE(yk::is_for_overwrite_constructible_v<yk::rvariant<Packet, int>>);
+    STATIC_REQUIRE(std::is_nothrow_constructible_v<yk::rvariant<Packet, int>, yk::for_overwrite_t>);
+    STATIC_REQUIRE(!yk::is_for_overwrite_constructible_v<yk::rvariant<std::string, int>>);
+    STATIC_REQUIRE(!std::is_constructible_v<yk::rvariant<std::string, int>, yk::for_overwrite_t>);
+    STATIC_REQUIRE(!yk::is_for_overwrite_constructible_v<Packet>);
+
+    STATIC_REQUIRE([] consteval {
+        yk::rvariant<int, double> v(yk::for_overwrite);
+        return v.index() == 0 && yk::get<0>(v) == 0; // value-initialized in constant evaluation
+    }());
+    {
+        yk::rvariant<Packet, int> v(yk::for_overwrite);
+        CHECK(v.index() == 0);
+        v = 42;
+        CHECK(yk::get<1>(v) == 42);
+    }
+    {
+        using V = yk::rvariant<Packet, int>;
+        std::vector<V, yk::default_init_allocator<V>> vars;
+        vars.resize(16);
+        CHECK(std::ranges::all_of(vars, [](V const& v) { return v.index() == 0; }));
+    }
+}
+
 TEST_CASE("generic construction")
 {
     {
@@ -1389,6 +1571,123 @@ TEST_CASE("self emplace")
     // operator of `rvariant` itself (not the generic one).
 }
 
+TEST_CASE("assign_or_emplace")
+{
+    {
+        using V = yk::rvariant<int, std::string>;
+        STATIC_REQUIRE(noexcept(std::declval<V&>().assign_or_emplace<0>(42)));
+        STATIC_REQUIRE(!noexcept(std::declval<V&>().assign_or_emplace<1>("foo")));
+
+        V a;
+        CHECK(a.assign_or_emplace<int>(42) == 42);
+        CHECK(a.index() == 0);
+
+        // type-changing; emplaces
+        a.assign_or_emplace<1>("foo").reserve(100);
+        CHECK(a.index() == 1);
+        CHECK(yk::get<1>(a) == "foo");
+
+        // non type-changing; assigns and preserves capacity
+        auto const* const data = yk::get<1>(a).data();
+        auto const capacity = yk::get<1>(a).capacity();
+        CHECK(a.assign_or_emplace<std::string>(std::string_view{"bar"}) == "bar");
+        CHECK(yk::get<1>(a).data() == data);
+        CHECK(yk::get<1>(a).capacity() == capacity);
+
+        // multiple arguments; emplaces
+        CHECK(a.assign_or_emplace<1>(3uz, 'x') == "xxx");
+        CHECK(a.index() == 1);
+    }
+    {
+        // assigns into the object owned by recursive_wrapper
+        using V = yk::rvariant<int, yk::recursive_wrapper<std::vector<int>>>;
+        V a(std::in_place_index<1>, std::vector<int>{1, 2, 3});
+        auto const* const vec = &yk::get<1>(a);
+        CHECK(a.assign_or_emplace<std::vector<int>>(std::vector<int>{4, 5}) == std::vector<int>{4, 5});
+        CHECK(&yk::get<1>(a) == vec);
+
+        auto const* const data = vec->data();
+        std::vector<int> const src{6, 7};
+        a.assign_or_emplace<1>(src);
+        CHECK(yk::get<1>(a) == src);
+        CHECK(yk::get<1>(a).data() == data);
+    }
+    {
+        auto a = make_valueless<int>(42);
+        REQUIRE(a.valueless_by_exception());
+        a.assign_or_emplace<0>(12);
+        CHECK(a.index() == 0);
+        CHECK(yk::get<0>(a) == 12);
+    }
+}
+
+namespace {
+
+struct Immovable
+{
+    int value;
+    explicit Immovable(int value) noexcept : value(value) {}
+    Immovable(Immovable const&) = delete;
+    Immovable(Immovable&&) = delete;
+    Immovable& operator=(Immovable const&) = delete;
+    Immovable& operator=(Immovable&&) = delete;
+};
+
+} // anonymous
+
+TEST_CASE("emplace_with")
+{
+    // guaranteed copy elision; works for non-movable types
+    {
+        using V = yk::rvariant<int, Immovable>;
+        STATIC_REQUIRE(std::is_nothrow_constructible_v<V, std::in_place_index_t<1>, yk::from_invoke_t, Immovable(*)() noexcept>);
+
+        V a(std::in_place_index<1>, yk::from_invoke, [] noexcept { return Immovable{42}; });
+        CHECK(a.index() == 1);
+        CHECK(yk::get<1>(a).value == 42);
+
+        V b(std::in_place_type<Immovable>, yk::from_invoke, [] { return Immovable{12}; });
+        CHECK(yk::get<1>(b).value == 12);
+
+        CHECK(a.emplace_with<0>([] { return 33; }) == 33);
+        CHECK(a.index() == 0);
+        CHECK(a.emplace_with<Immovable>([] { return Immovable{4}; }).value == 4);
+        CHECK(a.index() == 1);
+    }
+    // converting result
+    {
+        yk::rvariant<int, std::string> a(std::in_place_index<1>, yk::from_invoke, [] { return "foo"; });
+        CHECK(yk::get<1>(a) == "foo");
+        a.emplace_with<std::string>([] { return std::string_view{"bar"}; });
+        CHECK(yk::get<1>(a) == "bar");
+    }
+    // recursive_wrapper
+    {
+        yk::rvariant<int, yk::recursive_wrapper<std::string>> a(std::in_place_index<1>, yk::from_invoke, [] { return std::string{"foo"}; });
+        CHECK(yk::get<1>(a) == "foo");
+        CHECK(a.emplace_with<std::string>([] { return std::string{"bar"}; }) == "bar");
+    }
+    // never valueless; the contained value is kept if the callable throws
+    {
+        using V = yk::rvariant<int, double>;
+        STATIC_REQUIRE(is_never_valueless<V>);
+        V a(42);
+        REQUIRE_THROWS_AS(a.emplace_with<1>([]() -> double { throw Thrower_base::exception{}; }), Thrower_base::exception);  // NOLINT(hicpp-exception-baseclass)
+        CHECK(a.index() == 0);
+        CHECK(yk::get<0>(a) == 42);
+    }
+    // may become valueless
+    {
+        using V = yk::rvariant<int, std::string>;
+        STATIC_REQUIRE(!is_never_valueless<V>);
+        V a(std::in_place_index<1>, "foo");
+        REQUIRE_THROWS_AS(a.emplace_with<1>([]() -> std::string { throw Thrower_base::exception{}; }), Thrower_base::exception);  // NOLINT(hicpp-exception-baseclass)
+        CHECK(a.valueless_by_exception());
+        a.emplace_with<0>([] { return 12; });
+        CHECK(yk::get<0>(a) == 12);
+    }
+}
+
 TEST_CASE("swap")
 {
     {
@@ -1828,6 +2127,47 @@ TEST_CASE("relational operators")
     }
 }
 
+TEST_CASE("relational operators (bitwise)", "[detail]")
+{
+    STATIC_REQUIRE(yk::detail::is_bitwise_equality_comparable_all_v<int, unsigned, char>);
+    STATIC_REQUIRE(yk::detail::is_bitwise_equality_comparable_all_v<int, long long, int const*>);
+    STATIC_REQUIRE(!yk::detail::is_bitwise_equality_comparable_all_v<int, double>);
+
+    {
+        using V = yk::rvariant<int, unsigned, char>;
+        STATIC_REQUIRE(!yk::detail::is_uniform_size_v<int, unsigned, char>);
+        STATIC_CHECK(V{42} == V{42});
+        STATIC_CHECK(V{42} != V{42u});
+
+        CHECK(V{42} == V{42});
+        CHECK(V{42} != V{43});
+        CHECK(V{42} != V{42u});
+        CHECK(V{'a'} == V{'a'});
+        CHECK(V{'a'} != V{'b'});
+
+        V a{'a'}, b{'a'};
+        a = 0x12345678;
+        a = 'a'; // may leave garbage in the inactive bytes of `a`
+        CHECK(a == b);
+        CHECK(!(a != b));
+    }
+    {
+        using V = yk::rvariant<int, unsigned>;
+        STATIC_REQUIRE(yk::detail::is_uniform_size_v<int, unsigned>);
+        CHECK(V{42} == V{42});
+        CHECK(V{42} != V{42u});
+        CHECK(V{42u} == V{42u});
+        CHECK(V{-1} != V{~0u});
+    }
+    {
+        int x = 0, y = 0;
+        using V = yk::rvariant<int*, long long>;
+        CHECK(V{&x} == V{&x});
+        CHECK(V{&x} != V{&y});
+        CHECK(V{&x} != V{0LL});
+    }
+}
+
 namespace {
 
 template<class T>
@@ -1904,6 +2244,10 @@ TEST_CASE("pack_union", "[pack][detail]")
     STATIC_REQUIRE(std::is_same_v<pack_union_t<yk::rvariant, int, int>, yk::rvariant<int>>);
     STATIC_REQUIRE(std::is_same_v<pack_union_t<yk::rvariant, yk::rvariant<int, float>, yk::rvariant<int, double>>, yk::rvariant<int, float, double>>);
     STATIC_REQUIRE(std::is_same_v<pack_union_t<yk::rvariant, yk::rvariant<float, int>, yk::rvariant<int, double>>, yk::rvariant<float, int, double>>);
+
+    // duplicates within each side are removed too, keeping the first occurrence
+    STATIC_REQUIRE(std::is_same_v<pack_union_t<yk::rvariant, yk::rvariant<int, float, int>, yk::rvariant<double, float, double>>, yk::rvariant<int, float, double>>);
+    STATIC_REQUIRE(std::is_same_v<pack_union_t<yk::rvariant, int, yk::rvariant<>>, yk::rvariant<int>>);
 }
 
 TEST_CASE("compact_alternative", "[pack]")
@@ -0,0 +1,100 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/shared_rvariant.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace unit_test {
+
+namespace {
+
+struct Quote { long bid, ask, bid_size, ask_size, a, b, c, d; };
+struct Trade { long values[12]; };
+struct Halt { int reason; };
+
+} // anonymous
+
+TEST_CASE("shared_rvariant")
+{
+    STATIC_REQUIRE(yk::is_seqlock_publishable_v<yk::rvariant<int, double>>);
+    STATIC_REQUIRE(yk::is_seqlock_publishable_v<yk::rvariant<Quote, Trade, Halt>>);
+    STATIC_REQUIRE(!yk::is_seqlock_publishable_v<yk::rvariant<int, std::string>>);
+    STATIC_REQUIRE(!yk::is_seqlock_publishable_v<int>);
+
+    using V = yk::rvariant<int, double, Halt>;
+    {
+        yk::shared_rvariant<V> s;
+        CHECK(s.load() == V{0});
+        CHECK(s.version() == 0);
+    }
+    {
+        yk::shared_rvariant<V> s(std::in_place_index<1>, 3.14);
+        CHECK(s.load() == V{3.14});
+
+        s.emplace<0>(42);
+        CHECK(s.load() == V{42});
+        CHECK(s.version() == 1);
+
+        s.emplace<Halt>(Halt{7});
+        CHECK(s.version() == 2);
+        CHECK(s.visit([]<class T>(T const& x) {
+            if constexpr (std::is_same_v<T, Halt>) return x.reason;
+            else return -1;
+        }) == 7);
+
+        s.store(V{2.5});
+        CHECK(s.load() == V{2.5});
+    }
+}
+
+TEST_CASE("shared_rvariant (concurrent)")
+{
+    using V = yk::rvariant<Quote, Trade, Halt>;
+    yk::shared_rvariant<V> s(std::in_place_index<2>, Halt{0});
+
+    // every field of a published value is the same; a torn read would mix two writes
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    {
+        std::vector<std::jthread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&] {
+                while (!done.load(std::memory_order_relaxed)) {
+                    s.visit([&]<class T>(T const& x) {
+                        if constexpr (std::is_same_v<T, Quote>) {
+                            if (x.bid != x.d) ++torn;
+                        } else if constexpr (std::is_same_v<T, Trade>) {
+                            for (long const v : x.values) {
+                                if (v != x.values[0]) ++torn;
+                            }
+                        }
+                    });
+                }
+            });
+        }
+
+        for (long i = 0; i < 20000; ++i) {
+            if (i % 2 == 0) {
+                s.emplace<Quote>(Quote{i, i, i, i, i, i, i, i});
+            } else {
+                Trade t;
+                for (long& v : t.values) v = i;
+                s.emplace<Trade>(t);
+            }
+        }
+        done = true;
+    }
+    CHECK(torn == 0);
+    CHECK(s.version() == 20000);
+}
+
+} // unit_test
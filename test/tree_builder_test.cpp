@@ -0,0 +1,201 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/tree_builder.hpp"
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/recursive_wrapper.hpp"
+#include "yk/rvariant/recursive_wrapper_pmr.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace unit_test {
+
+namespace {
+
+namespace json {
+
+struct Array;
+struct Object;
+
+using Value = yk::rvariant<
+    std::monostate,
+    bool,
+    double,
+    std::string,
+    yk::recursive_wrapper<Array>,
+    yk::recursive_wrapper<Object>
+>;
+
+struct Array : std::vector<Value>
+{
+    using vector::vector;
+};
+
+struct Object : std::map<std::string, Value, std::less<>>
+{
+    using map::map;
+};
+
+} // json
+
+namespace pmr_json {
+
+struct Array;
+struct Members;
+
+using Value = yk::rvariant<
+    std::monostate,
+    double,
+    std::pmr::string,
+    yk::pmr::recursive_wrapper<Array>,
+    yk::pmr::recursive_wrapper<Members>
+>;
+
+struct Array : std::pmr::vector<Value>
+{
+    using vector::vector;
+};
+
+struct Members : std::pmr::vector<std::pair<std::pmr::string, Value>>
+{
+    using vector::vector;
+};
+
+} // pmr_json
+
+} // anonymous
+
+TEST_CASE("tree_builder")
+{
+    using json::Value;
+    using json::Array;
+    using json::Object;
+
+    {
+        yk::tree_builder<Value, Array, Object> b;
+        b.value(42.0);
+        REQUIRE(b.complete());
+        Value const v = b.release();
+        REQUIRE(v.index() == 2);
+        CHECK(yk::get<2>(v) == 42.0);
+    }
+    {
+        // {"a": 1, "b": [true, "x", [], null]}
+        yk::tree_builder<Value, Array, Object> b;
+        b.begin<Object>();
+        {
+            b.key("a");
+            b.value(1.0);
+            b.key("b");
+            b.begin<Array>();
+            {
+                b.value(true);
+                b.value("x");
+                b.begin<Array>();
+                CHECK(b.depth() == 3);
+                b.end();
+                b.value();
+            }
+            b.end();
+        }
+        CHECK_FALSE(b.complete());
+        b.end();
+        REQUIRE(b.complete());
+
+        Value const& v = b.root();
+        REQUIRE(v.index() == 5);
+        Object const& obj = yk::get<5>(v);
+        REQUIRE(obj.size() == 2);
+        CHECK(yk::get<2>(obj.at("a")) == 1.0);
+
+        Array const& arr = yk::get<4>(obj.at("b"));
+        REQUIRE(arr.size() == 4);
+        CHECK(yk::get<1>(arr[0]) == true);
+        CHECK(yk::get<3>(arr[1]) == "x");
+        CHECK(yk::get<4>(arr[2]).empty());
+        CHECK(arr[3].index() == 0);
+    }
+    {
+        // duplicate key; the last one wins
+        yk::tree_builder<Value, Array, Object> b;
+        b.begin<Object>();
+        b.key("a");
+        b.value(1.0);
+        b.key("a");
+        b.begin<Array>();
+        b.value(2.0);
+        b.end();
+        b.end();
+
+        Object const& obj = yk::get<5>(b.root());
+        REQUIRE(obj.size() == 1);
+        REQUIRE(obj.at("a").index() == 4);
+        CHECK(yk::get<4>(obj.at("a")).size() == 1);
+    }
+    {
+        // deep nesting
+        constexpr std::size_t depth = 1000;
+        yk::tree_builder<Value, Array, Object> b;
+        for (std::size_t i = 0; i < depth; ++i) {
+            b.begin<Array>();
+            b.value(static_cast<double>(i));
+        }
+        CHECK(b.depth() == depth);
+        for (std::size_t i = 0; i < depth; ++i) {
+            b.end();
+        }
+        REQUIRE(b.complete());
+
+        Value const* node = &b.root();
+        for (std::size_t i = 0; i < depth; ++i) {
+            Array const& arr = yk::get<4>(*node);
+            REQUIRE(arr.size() == (i + 1 < depth ? 2 : 1));
+            CHECK(yk::get<2>(arr[0]) == static_cast<double>(i));
+            if (i + 1 < depth) node = &arr[1];
+        }
+    }
+}
+
+TEST_CASE("tree_builder", "[pmr]")
+{
+    using pmr_json::Value;
+    using pmr_json::Array;
+    using pmr_json::Members;
+
+    std::pmr::monotonic_buffer_resource mr;
+    {
+        // {"a": [1, "x"]}
+        yk::tree_builder<Value, Array, Members> b(&mr);
+        b.begin<Members>();
+        b.key("a");
+        b.begin<Array>();
+        b.value(1.0);
+        b.value(std::in_place_index<2>, "x", &mr);
+        b.end();
+        b.end();
+        REQUIRE(b.complete());
+
+        Members const& members = yk::get<4>(b.root());
+        CHECK(members.get_allocator().resource() == &mr);
+        REQUIRE(members.size() == 1);
+        CHECK(members[0].first == "a");
+        CHECK(members[0].first.get_allocator().resource() == &mr);
+
+        Array const& arr = yk::get<3>(members[0].second);
+        CHECK(arr.get_allocator().resource() == &mr);
+        REQUIRE(arr.size() == 2);
+        CHECK(yk::get<1>(arr[0]) == 1.0);
+        CHECK(yk::get<2>(arr[1]) == "x");
+        CHECK(yk::get<2>(arr[1]).get_allocator().resource() == &mr);
+    }
+}
+
+} // unit_test
@@ -0,0 +1,174 @@
+﻿// Copyright 2025 Nana Sakisaka
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include "yk/rvariant/rvariant.hpp"
+#include "yk/rvariant/variant_hash.hpp"
+#include "yk/rvariant/recursive_wrapper.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace unit_test {
+
+TEST_CASE("variant_hash")
+{
+    using V = yk::rvariant<int, std::string, double>;
+    using H = yk::variant_hash<V>;
+    using E = yk::variant_equal_to<V>;
+    using namespace std::string_view_literals;
+
+    STATIC_REQUIRE(yk::is_hash_compatible_v<std::string, std::string_view>);
+    STATIC_REQUIRE(!yk::is_hash_compatible_v<std::string, char const*>);
+
+    {
+        std::string const long_str(64, 'x');
+        CHECK(H{}(42) == std::hash<V>{}(V{42}));
+        CHECK(H{}(3.14) == std::hash<V>{}(V{3.14}));
+        CHECK(H{}(long_str) == std::hash<V>{}(V{long_str}));
+        CHECK(H{}(std::string_view{long_str}) == std::hash<V>{}(V{long_str}));
+        CHECK(H{}(long_str.c_str()) == std::hash<V>{}(V{long_str}));
+        CHECK(H{}("foo") == std::hash<V>{}(V{"foo"}));
+        CHECK(H{}(V{"foo"}) == std::hash<V>{}(V{"foo"}));
+    }
+    {
+        CHECK(E{}(V{"foo"}, "foo"sv));
+        CHECK(E{}("foo"sv, V{"foo"}));
+        CHECK(E{}(V{"foo"}, "foo"));
+        CHECK_FALSE(E{}(V{"foo"}, "bar"sv));
+        CHECK_FALSE(E{}(V{42}, "foo"sv));
+        CHECK(E{}(V{42}, 42));
+        CHECK_FALSE(E{}(V{42}, 43));
+        CHECK_FALSE(E{}(V{42.0}, 42));
+    }
+    {
+        // Both alternatives are hash-compatible with `std::string_view`;
+        // falls back to the alternative selected by the converting constructor
+        using W = yk::rvariant<std::string, std::string_view>;
+        CHECK(yk::variant_hash<W>{}(std::string("foo")) == std::hash<W>{}(W{std::string("foo")}));
+        CHECK(yk::variant_hash<W>{}("foo"sv) == std::hash<W>{}(W{"foo"sv}));
+        CHECK_FALSE(yk::variant_equal_to<W>{}(W{std::string("foo")}, "foo"sv));
+
+        // no alternative is selected
+        using X = yk::rvariant<int, std::string>;
+        STATIC_REQUIRE(!std::is_invocable_v<yk::variant_hash<X>, std::nullptr_t>);
+    }
+}
+
+TEST_CASE("variant_hash (recursive_wrapper)")
+{
+    using V = yk::rvariant<int, yk::recursive_wrapper<std::string>>;
+    using H = yk::variant_hash<V>;
+    using E = yk::variant_equal_to<V>;
+    using namespace std::string_view_literals;
+
+    V const v{std::string("foo")};
+    CHECK(H{}("foo"sv) == std::hash<V>{}(v));
+    CHECK(H{}(std::string("foo")) == std::hash<V>{}(v));
+    CHECK(E{}(v, "foo"sv));
+    CHECK_FALSE(E{}(v, "bar"sv));
+}
+
+TEST_CASE("variant_hash (unordered containers)")
+{
+    using V = yk::rvariant<int, std::string>;
+    using namespace std::string_view_literals;
+
+    std::unordered_map<V, int, yk::variant_hash<V>, yk::variant_equal_to<V>> map;
+    map.emplace(V{1}, 10);
+    map.emplace(V{std::string(100, 'a')}, 20);
+    map.emplace(V{"1"}, 30);
+
+    {
+        auto const it = map.find(std::string_view(std::string(100, 'a')));
+        REQUIRE(it != map.end());
+        CHECK(it->second == 20);
+    }
+    {
+        auto const it = map.find(1);
+        REQUIRE(it != map.end());
+        CHECK(it->second == 10);
+    }
+    {
+        auto const it = map.find("1"sv);
+        REQUIRE(it != map.end());
+        CHECK(it->second == 30);
+    }
+    CHECK(map.find(2) == map.end());
+    CHECK(map.find("2"sv) == map.end());
+    CHECK(map.contains("1"));
+
+    std::unordered_set<V, yk::variant_hash<V>, yk::variant_equal_to<V>> set{V{42}, V{"foo"}};
+    CHECK(set.contains(42));
+    CHECK(set.contains("foo"sv));
+    CHECK_FALSE(set.contains("bar"sv));
+}
+
+TEST_CASE("rvariant_hasher")
+{
+    using V = yk::rvariant<int, long long, std::string>;
+
+    {
+        yk::rvariant_hasher<yk::index_mixer> const h;
+        CHECK(h(V{42}) == std::hash<V>{}(V{42}));
+        CHECK(h(V{42LL}) == std::hash<V>{}(V{42LL}));
+        CHECK(h(V{"foo"}) == std::hash<V>{}(V{"foo"}));
+    }
+    {
+        yk::rvariant_hasher<> const h;
+        CHECK(h(V{42}) == h(V{42}));
+        CHECK(h(V{42}) != h(V{42LL}));
+        CHECK(h(V{42}) != std::hash<V>{}(V{42}));
+
+        yk::rvariant_hasher<yk::avalanche_mixer> const seeded{yk::avalanche_mixer{12345}};
+        CHECK(seeded(V{42}) == seeded(V{42}));
+        CHECK(seeded(V{42}) != h(V{42}));
+    }
+    {
+        CHECK(yk::process_hash_seed() == yk::process_hash_seed());
+        yk::rvariant_hasher<yk::seeded_avalanche_mixer> const h1, h2;
+        CHECK(h1(V{42}) == h2(V{42}));
+    }
+    {
+        // Sequential integers across alternatives shall not cluster in the low bits
+        constexpr std::size_t N = 1024;
+        constexpr std::size_t mask = 2 * N - 1;
+        yk::rvariant_hasher<> const h;
+        std::unordered_set<std::size_t> low_bits;
+        for (std::size_t i = 0; i < N; ++i) {
+            low_bits.insert(h(V{static_cast<int>(i)}) & mask);
+            low_bits.insert(h(V{static_cast<long long>(i)}) & mask);
+        }
+        // 2N balls into 2N bins; expected occupancy is (1 - 1/e) ~ 63%
+        CHECK(low_bits.size() > N);
+    }
+}
+
+TEST_CASE("variant_hash (mixer)")
+{
+    using V = yk::rvariant<int, std::string>;
+    using H = yk::variant_hash<V, yk::avalanche_mixer>;
+    using namespace std::string_view_literals;
+
+    CHECK(H{}(42) == yk::rvariant_hasher<yk::avalanche_mixer>{}(V{42}));
+    CHECK(H{}("foo"sv) == yk::rvariant_hasher<yk::avalanche_mixer>{}(V{"foo"}));
+    CHECK(H{}(V{"foo"}) == yk::rvariant_hasher<yk::avalanche_mixer>{}(V{"foo"}));
+
+    H const seeded{yk::avalanche_mixer{12345}};
+    CHECK(seeded(42) == yk::rvariant_hasher<yk::avalanche_mixer>{yk::avalanche_mixer{12345}}(V{42}));
+
+    std::unordered_map<V, int, yk::variant_hash<V, yk::seeded_avalanche_mixer>, yk::variant_equal_to<V>> map;
+    map.emplace(V{"foo"}, 42);
+    map.emplace(V{42}, 43);
+    CHECK(map.find("foo"sv)->second == 42);
+    CHECK(map.find(42)->second == 43);
+}
+
+} // unit_test